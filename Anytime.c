@@ -0,0 +1,157 @@
+// Anytime.c ... Anytime ADT implementation
+// Times the turn on the monotonic clock, which never jumps when the
+// system's time of day is changed under us
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include "Globals.h"
+#include "Game.h"
+#include "Places.h"
+#include "PlayDecoder.h"
+#include "Anytime.h"
+
+// a move as registered: two chars and a terminator
+#define MOVE_SIZE 3
+
+#define MSECS_PER_SEC 1000.0
+#define NSECS_PER_MSEC 1000000.0
+
+struct anytime {
+    // when the clock started, and how long we have from then
+    struct timespec start;
+    double msecsAllowed;
+
+    // the best move so far
+    LocationID move;
+    int depth;
+    double score;
+
+    // and the one the engine has
+    LocationID registered;
+};
+
+static void registerMove(Anytime a, const char *message);
+
+// Starts the clock on a turn
+Anytime newAnytime(int budgetMsecs, int safetyMsecs)
+{
+    assert(budgetMsecs > 0);
+    assert(safetyMsecs >= 0);
+
+    Anytime a = malloc(sizeof(struct anytime));
+    assert(a != NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &a->start);
+    a->msecsAllowed = budgetMsecs - safetyMsecs;
+
+    a->move = NOWHERE;
+    a->depth = 0;
+    a->score = 0;
+    a->registered = NOWHERE;
+
+    return a;
+}
+
+// Frees all memory allocated for toBeDeleted
+void disposeAnytime(Anytime toBeDeleted)
+{
+    assert(toBeDeleted != NULL);
+    free(toBeDeleted);
+}
+
+// How long since the clock started
+double msecsUsed(Anytime a)
+{
+    assert(a != NULL);
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - a->start.tv_sec) * MSECS_PER_SEC +
+           (now.tv_nsec - a->start.tv_nsec) / NSECS_PER_MSEC;
+}
+
+// Is there no more time to search
+int timeIsUp(Anytime a)
+{
+    return msecsUsed(a) >= a->msecsAllowed;
+}
+
+// Puts forward a move, registering it if it's the best one yet
+int offerMove(Anytime a, LocationID move, int depth, double score,
+              const char *message)
+{
+    assert(a != NULL);
+    assert(encodeMove(move) != NULL);
+    assert(message != NULL);
+
+    int better = (a->move == NOWHERE || depth > a->depth ||
+                  (depth == a->depth && score > a->score));
+    if(better) {
+        a->move = move;
+        a->depth = depth;
+        a->score = score;
+
+        if(move != a->registered) {
+            registerMove(a, message);
+        }
+    }
+    return better;
+}
+
+// Registers the best move again
+void restateMove(Anytime a, const char *message)
+{
+    assert(a != NULL);
+    assert(message != NULL);
+
+    if(a->move != NOWHERE) {
+        registerMove(a, message);
+    }
+}
+
+// The best move so far
+LocationID bestMove(Anytime a)
+{
+    assert(a != NULL);
+    return a->move;
+}
+
+// How far the search behind the best move looked
+int bestDepth(Anytime a)
+{
+    assert(a != NULL);
+    return a->depth;
+}
+
+// Hands the best move to the engine
+static void registerMove(Anytime a, const char *message)
+{
+    // the engine wants both in arrays it can write to
+    char play[MOVE_SIZE];
+    PlayerMessage copy;
+    strncpy(play, encodeMove(a->move), MOVE_SIZE - 1);
+    play[MOVE_SIZE - 1] = '\0';
+    strncpy(copy, message, MESSAGE_SIZE - 1);
+    copy[MESSAGE_SIZE - 1] = '\0';
+
+    registerBestPlay(play, copy);
+    a->registered = a->move;
+}
+
+// Iterative deepening
+int deepen(Anytime a, AnytimeSearch search, void *data, int maxDepth)
+{
+    assert(a != NULL);
+    assert(search != NULL);
+
+    int done = 0;
+    int depth = 1;
+    while(depth <= maxDepth && !timeIsUp(a) &&
+          search(a, depth, data) == TRUE) {
+        done = depth;
+        depth++;
+    }
+    return done;
+}
@@ -0,0 +1,79 @@
+// Anytime.h ... making the most of the time allowed for a move
+// The engine stops a player after LIMIT_LIMIT_MSECS and plays whatever it
+// registered last. So a player registers something safe straight away,
+// then keeps searching and registers again each time it finds a better
+// move, stopping a little before the deadline
+
+#ifndef ANYTIME_H
+#define ANYTIME_H
+
+#include "Globals.h"
+#include "Game.h"
+#include "Places.h"
+
+typedef struct anytime *Anytime;
+
+// how long before the engine's deadline to stop, by default
+// (the engine's clock starts before ours, and stopping takes a while)
+#define DEFAULT_SAFETY_MSECS 150
+
+// newAnytime() starts the clock on a turn of budgetMsecs (normally
+//   LIMIT_LIMIT_MSECS), which is up safetyMsecs before the end of it
+
+Anytime newAnytime(int budgetMsecs, int safetyMsecs);
+
+// disposeAnytime() frees all memory allocated for toBeDeleted
+// Whatever was registered last stays registered
+
+void disposeAnytime(Anytime toBeDeleted);
+
+// msecsUsed() gives how long it's been since the clock started
+
+double msecsUsed(Anytime a);
+
+// timeIsUp() is TRUE once there's no more time to search
+// It reads the clock every time, so very tight loops should only ask
+//   every so often
+
+int timeIsUp(Anytime a);
+
+// offerMove() puts forward move (a place or, for Dracula, HIDE,
+//   DOUBLE_BACK_N or TELEPORT) as found by a search that looked depth
+//   far ahead and rated it score, higher being better
+// It becomes the best move if nothing has been offered yet, if depth is
+//   further than the best move's, or if it's as far and scores higher;
+//   it's registered with the engine, along with message, if it differs
+//   from the move registered last
+// Returns TRUE if it became the best move
+
+int offerMove(Anytime a, LocationID move, int depth, double score,
+              const char *message);
+
+// restateMove() registers the best move again with a new message, say
+//   to report how the search went; does nothing if there's no best move
+
+void restateMove(Anytime a, const char *message);
+
+// bestMove() gives the best move offered so far, or NOWHERE if none
+
+LocationID bestMove(Anytime a);
+
+// bestDepth() gives how far ahead the search behind the best move looked
+
+int bestDepth(Anytime a);
+
+// One pass of an iterative deepening search: search depth far ahead and
+//   offerMove() the best move found
+// data is whatever was given to deepen()
+// Returns TRUE if it finished, FALSE if it stopped because the time was
+//   up or there's no point looking further
+
+typedef int (*AnytimeSearch)(Anytime a, int depth, void *data);
+
+// deepen() runs search with depths 1, 2, ... maxDepth while there's time,
+//   stopping at the first pass that doesn't finish
+// Returns the depth of the last pass that did
+
+int deepen(Anytime a, AnytimeSearch search, void *data, int maxDepth);
+
+#endif
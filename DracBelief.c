@@ -0,0 +1,242 @@
+// DracBelief.c ... DracBelief ADT implementation
+
+#include <stdlib.h>
+#include <assert.h>
+#include "Globals.h"
+#include "Places.h"
+#include "Map.h"
+#include "LocationSet.h"
+#include "PlayDecoder.h"
+#include "DracBelief.h"
+
+// how Dracula can move; he never has rail
+#define DRACULA_MOVES (MOVE_ROAD | MOVE_SEA)
+
+// first and last double back
+#define DOUBLE_BACK_FIRST DOUBLE_BACK_1
+#define DOUBLE_BACK_LAST DOUBLE_BACK_5
+
+struct dracBelief {
+    // everywhere he might have been on each of his last TRAIL_SIZE turns;
+    // most recent first
+    LocationSet possible[TRAIL_SIZE];
+
+    // the move that took him to each of those places
+    LocationID moves[TRAIL_SIZE];
+
+    // how many of those there are so far
+    int numKnown;
+};
+
+static LocationSet reachFrom(LocationSet from);
+static int narrow(LocationSet *s, LocationSet by);
+static int linkSlots(DracBelief b, int i);
+static void tighten(DracBelief b);
+static void addDraculaPlay(DracBelief b, const PlayRecord *play);
+static void addHunterPlay(DracBelief b, const PlayRecord *play);
+
+// Starts off knowing nothing
+DracBelief newDracBelief(void)
+{
+    DracBelief b = malloc(sizeof(struct dracBelief));
+    assert(b != NULL);
+
+    int i;
+    for(i = 0; i < TRAIL_SIZE; i++) {
+        b->possible[i] = setEmpty();
+        b->moves[i] = NOWHERE;
+    }
+    b->numKnown = 0;
+
+    return b;
+}
+
+// Frees all memory allocated for toBeDeleted
+void disposeDracBelief(DracBelief toBeDeleted)
+{
+    assert(toBeDeleted != NULL);
+    free(toBeDeleted);
+}
+
+// Takes the next play into account
+void updateBelief(DracBelief b, const PlayRecord *play)
+{
+    assert(b != NULL);
+    assert(play != NULL);
+
+    if(play->player == PLAYER_DRACULA) {
+        addDraculaPlay(b, play);
+    } else {
+        addHunterPlay(b, play);
+    }
+
+    tighten(b);
+}
+
+// Where he might have been, turnsAgo turns ago
+LocationSet possibleLocations(DracBelief b, int turnsAgo)
+{
+    assert(b != NULL);
+    assert(0 <= turnsAgo && turnsAgo < TRAIL_SIZE);
+    return b->possible[turnsAgo];
+}
+
+// Everywhere Dracula could get to in one move from anywhere in from
+// (including staying put, which the map's move sets count)
+static LocationSet reachFrom(LocationSet from)
+{
+    Map map = getMap();
+    LocationSet reach = setEmpty();
+
+    LocationID v;
+    for(v = setNext(from, 0); v != NOWHERE; v = setNext(from, v+1)) {
+        reach = setUnion(reach, draculaMoveSet(map, v, DRACULA_MOVES));
+    }
+    return reach;
+}
+
+// Cuts s down to what's also in by, unless that leaves nothing (which
+// only happens if the plays contradict each other; we'd rather keep the
+// looser answer than none); returns whether s changed
+static int narrow(LocationSet *s, LocationSet by)
+{
+    LocationSet both = setIntersect(*s, by);
+
+    int changed = FALSE;
+    if(!setIsEmpty(both) && !setEquals(both, *s)) {
+        *s = both;
+        changed = TRUE;
+    }
+    return changed;
+}
+
+// Applies what the move into slot i says about slot i+1 and back again;
+// returns whether anything changed
+static int linkSlots(DracBelief b, int i)
+{
+    LocationID move = b->moves[i];
+    LocationSet *here = &b->possible[i];
+    LocationSet *before = &b->possible[i+1];
+
+    int changed = FALSE;
+    if(move == TELEPORT) {
+        // he could have teleported from anywhere
+    } else if(move == HIDE) {
+        // he stayed where he was
+        changed |= narrow(here, *before);
+        changed |= narrow(before, *here);
+    } else {
+        // an ordinary move or a double back: one move by road or sea
+        changed |= narrow(here, reachFrom(*before));
+        changed |= narrow(before, reachFrom(*here));
+
+        // and a double back is also the same place as one in the trail
+        if(DOUBLE_BACK_FIRST <= move && move <= DOUBLE_BACK_LAST) {
+            int back = i + (move - DOUBLE_BACK_FIRST) + 1;
+            if(back < b->numKnown) {
+                changed |= narrow(here, b->possible[back]);
+                changed |= narrow(&b->possible[back], *here);
+            }
+        }
+    }
+    return changed;
+}
+
+// Keeps going over the trail until nothing changes
+static void tighten(DracBelief b)
+{
+    int changed = TRUE;
+    while(changed == TRUE) {
+        changed = FALSE;
+
+        int i;
+        for(i = 0; i + 1 < b->numKnown; i++) {
+            changed |= linkSlots(b, i);
+        }
+    }
+}
+
+// One of Dracula's own plays: a new place at the front of his trail
+static void addDraculaPlay(DracBelief b, const PlayRecord *play)
+{
+    Map map = getMap();
+    LocationSet seas = seaSet(map);
+    LocationSet land = setMinus(setAll(), seas);
+    LocationID move = play->move;
+
+    int i;
+    for(i = TRAIL_SIZE-1; i > 0; i--) {
+        b->possible[i] = b->possible[i-1];
+        b->moves[i] = b->moves[i-1];
+    }
+    b->moves[0] = move;
+    if(b->numKnown < TRAIL_SIZE) {
+        b->numKnown++;
+    }
+
+    // anywhere he can get to this turn
+    LocationSet reach;
+    if(b->numKnown == 1) {
+        // his first move can be anywhere but the hospital
+        reach = setAll();
+        setRemove(&reach, ST_JOSEPH_AND_ST_MARYS);
+    } else {
+        reach = reachFrom(b->possible[1]);
+    }
+
+    // places we know are in his trail (other than where he is leaving
+    // from, which he can't move to anyway), which an ordinary move
+    // can't take him to
+    LocationSet inTrail = setEmpty();
+    for(i = 1; i < b->numKnown; i++) {
+        if(setSize(b->possible[i]) == 1) {
+            inTrail = setUnion(inTrail, b->possible[i]);
+        }
+    }
+
+    LocationSet now;
+    if(validPlace(move)) {
+        // he's been revealed
+        now = setOf(move);
+    } else if(move == TELEPORT) {
+        now = setOf(CASTLE_DRACULA);
+    } else if(move == CITY_UNKNOWN) {
+        now = setMinus(setIntersect(reach, land), inTrail);
+    } else if(move == SEA_UNKNOWN) {
+        now = setMinus(setIntersect(reach, seas), inTrail);
+    } else if(move == HIDE) {
+        // staying put, and he can't hide at sea
+        now = setIntersect(b->possible[1], land);
+    } else if(DOUBLE_BACK_FIRST <= move && move <= DOUBLE_BACK_LAST &&
+              (move - DOUBLE_BACK_FIRST) + 1 < b->numKnown) {
+        // back to a place in his trail; linkSlots() checks he can get there
+        now = b->possible[(move - DOUBLE_BACK_FIRST) + 1];
+    } else {
+        // a play we can't make sense of
+        now = reach;
+    }
+
+    // keep something, even if the plays contradict each other
+    if(setIsEmpty(now)) {
+        now = reach;
+    }
+    b->possible[0] = now;
+}
+
+// A hunter's play: finding Dracula (or not) where they end up
+static void addHunterPlay(DracBelief b, const PlayRecord *play)
+{
+    LocationID where = play->location;
+
+    if(b->numKnown > 0 && validPlace(where)) {
+        if(play->encounters & ENCOUNTER_DRACULA) {
+            narrow(&b->possible[0], setOf(where));
+        } else if(idToType(where) != SEA &&
+                  (play->encounters & ENCOUNTER_TRAPS_MASK) == 0) {
+            // he isn't there, or they'd have run into him; unless they
+            // were stopped by traps first, or it's a sea (where nobody
+            // meets anybody)
+            narrow(&b->possible[0], setMinus(setAll(), setOf(where)));
+        }
+    }
+}
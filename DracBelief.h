@@ -0,0 +1,47 @@
+// DracBelief.h ... where Dracula might be, as far as the hunters can tell
+// Keeps a LocationSet of candidates for each place in Dracula's trail and
+// narrows them down with every play, using nothing but set operations on
+// the precomputed map tables, so reading the answer costs nothing
+
+#ifndef DRAC_BELIEF_H
+#define DRAC_BELIEF_H
+
+#include "Globals.h"
+#include "Places.h"
+#include "LocationSet.h"
+#include "PlayDecoder.h"
+
+typedef struct dracBelief *DracBelief;
+
+// newDracBelief() starts with no plays seen, when Dracula could be
+//   anywhere but the hospital
+
+DracBelief newDracBelief(void);
+
+// disposeDracBelief() frees all memory allocated for toBeDeleted
+
+void disposeDracBelief(DracBelief toBeDeleted);
+
+// updateBelief() takes the next play of the game, as GameView decoded it
+// Plays must be given in order, every player's included, since hunters
+//   that don't run into Dracula rule out where they are
+// It takes account of:
+//   where Dracula's plays reveal him to be (and land or sea if not)
+//   HIDE and DOUBLE_BACK_N taking him back to a place in his trail
+//   his moves only going by road or sea, and never to the hospital
+//   ordinary moves not going anywhere he knows is in his trail
+//   hunters who do or don't encounter him
+// and then works back along the trail, since each of those also says
+//   something about where he came from
+
+void updateBelief(DracBelief b, const PlayRecord *play);
+
+// possibleLocations() gives every location Dracula might have been at
+//   turnsAgo of his own turns ago, in the interval [0...TRAIL_SIZE-1]
+//   (0 is where he is now)
+// The set is empty if he hadn't had that many turns yet, and never
+//   includes CITY_UNKNOWN etc: it's always real places
+
+LocationSet possibleLocations(DracBelief b, int turnsAgo);
+
+#endif
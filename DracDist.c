@@ -0,0 +1,479 @@
+// DracDist.c ... DracDist ADT implementation
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "Globals.h"
+#include "Places.h"
+#include "Map.h"
+#include "LocationSet.h"
+#include "PlayDecoder.h"
+#include "DracBelief.h"
+#include "Random.h"
+#include "DracDist.h"
+
+// how Dracula can move; he never has rail
+#define DRACULA_MOVES (MOVE_ROAD | MOVE_SEA)
+
+// first and last double back
+#define DOUBLE_BACK_FIRST DOUBLE_BACK_1
+#define DOUBLE_BACK_LAST DOUBLE_BACK_5
+
+// one guess at Dracula's trail; most recent first, NOWHERE if not known
+typedef struct particle {
+    signed char trail[TRAIL_SIZE];
+} Particle;
+
+struct dracDist {
+    DracMoveModel model;
+    void *modelData;
+
+    // DIST_EXACT, or how many particles
+    int numParticles;
+
+    // exact: how likely each place is for each place in his trail, most
+    // recent first; older places are kept for his double backs
+    double weights[TRAIL_SIZE][NUM_MAP_LOCATIONS];
+
+    // how many turns of his trail we have
+    int numKnown;
+
+    // how likely he is to be at each place now, and the running total of
+    // that (to sample from); kept up to date in either mode
+    double now[NUM_MAP_LOCATIONS];
+    double cumulative[NUM_MAP_LOCATIONS];
+
+    // particles, and room to resample them into; on the end of the struct
+    Particle *particles;
+    Particle *spare;
+    RandomState rng;
+};
+
+static LocationSet legalMoves(LocationID from, LocationID move,
+                              LocationSet avoid);
+static int moveWeights(DracDist d, LocationID from, LocationSet options,
+                       double w[NUM_MAP_LOCATIONS]);
+static void spread(double *into, LocationSet where);
+static void keepOnly(DracDist d, double *w, LocationSet where);
+static void exactDraculaPlay(DracDist d, LocationID move, LocationSet mightBe);
+static LocationID moveParticle(DracDist d, Particle *p, LocationID move);
+static void particlePlay(DracDist d, LocationID move, LocationSet mightBe);
+static void resample(DracDist d, LocationSet mightBe);
+static void summarise(DracDist d);
+
+// Equally likely to go anywhere
+double uniformMoveModel(LocationID from, LocationID to, void *data)
+{
+    return 1.0;
+}
+
+// Starts a distribution with no plays seen
+DracDist newDracDist(int numParticles, DracMoveModel model, void *modelData,
+                     uint64_t seed)
+{
+    assert(numParticles >= 0);
+
+    // the particles (twice over) go on the end
+    DracDist d = malloc(sizeof(struct dracDist) +
+                        2 * numParticles * sizeof(Particle));
+    assert(d != NULL);
+
+    d->model = (model != NULL) ? model : uniformMoveModel;
+    d->modelData = modelData;
+    d->numParticles = numParticles;
+    d->numKnown = 0;
+    memset(d->weights, 0, sizeof(d->weights));
+    memset(d->now, 0, sizeof(d->now));
+    memset(d->cumulative, 0, sizeof(d->cumulative));
+
+    d->particles = (Particle *)(d + 1);
+    d->spare = d->particles + numParticles;
+    seedRandom(&d->rng, seed);
+
+    return d;
+}
+
+// Frees all memory allocated for toBeDeleted
+void disposeDracDist(DracDist toBeDeleted)
+{
+    assert(toBeDeleted != NULL);
+    free(toBeDeleted);
+}
+
+// Takes the next play into account
+void updateDist(DracDist d, const PlayRecord *play, DracBelief belief)
+{
+    assert(d != NULL);
+    assert(play != NULL);
+    assert(belief != NULL);
+
+    // the belief already has everything the plays rule out
+    LocationSet mightBe = possibleLocations(belief, 0);
+
+    if(play->player == PLAYER_DRACULA) {
+        if(d->numParticles == DIST_EXACT) {
+            exactDraculaPlay(d, play->move, mightBe);
+        } else {
+            particlePlay(d, play->move, mightBe);
+        }
+        if(d->numKnown < TRAIL_SIZE) {
+            d->numKnown++;
+        }
+    } else if(d->numKnown > 0) {
+        // a hunter may have ruled some places out
+        if(d->numParticles == DIST_EXACT) {
+            keepOnly(d, d->weights[0], mightBe);
+        } else {
+            resample(d, mightBe);
+        }
+    }
+
+    summarise(d);
+}
+
+// How likely he is to be at where
+double distProbability(DracDist d, LocationID where)
+{
+    assert(d != NULL);
+    assert(validPlace(where));
+    return d->now[where];
+}
+
+// The k most likely places, most likely first
+int distTopK(DracDist d, int k, LocationID locs[])
+{
+    assert(d != NULL);
+    assert(k >= 0);
+    assert(locs != NULL);
+
+    // insertion sort into a list at most k long
+    int n = 0;
+    LocationID v;
+    for(v = 0; v < NUM_MAP_LOCATIONS; v++) {
+        if(d->now[v] > 0) {
+            int i = (n < k) ? n++ : k;
+            while(i > 0 && d->now[locs[i-1]] < d->now[v]) {
+                if(i < k) {
+                    locs[i] = locs[i-1];
+                }
+                i--;
+            }
+            if(i < k) {
+                locs[i] = v;
+            }
+        }
+    }
+    return n;
+}
+
+// Picks somewhere for him, as likely as the distribution says
+LocationID distSample(DracDist d, RandomState *rng)
+{
+    assert(d != NULL);
+    assert(rng != NULL);
+
+    LocationID ret = NOWHERE;
+    if(d->numKnown > 0) {
+        double total = d->cumulative[NUM_MAP_LOCATIONS-1];
+        double x = randomUnit(rng) * total;
+
+        // find the first place whose running total is past x
+        int lo = 0;
+        int hi = NUM_MAP_LOCATIONS-1;
+        while(lo < hi) {
+            int mid = (lo + hi) / 2;
+            if(d->cumulative[mid] > x) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        ret = lo;
+    }
+    return ret;
+}
+
+// Everywhere the given move could take him from 'from', not counting
+// anywhere in avoid for an ordinary move
+static LocationSet legalMoves(LocationID from, LocationID move,
+                              LocationSet avoid)
+{
+    Map map = getMap();
+    LocationSet reach = draculaMoveSet(map, from, DRACULA_MOVES);
+    LocationSet seas = seaSet(map);
+
+    LocationSet ret;
+    if(validPlace(move)) {
+        ret = setIntersect(setMinus(reach, avoid), setOf(move));
+    } else if(move == CITY_UNKNOWN) {
+        ret = setMinus(setMinus(reach, seas), avoid);
+    } else if(move == SEA_UNKNOWN) {
+        ret = setIntersect(setMinus(reach, avoid), seas);
+    } else if(move == TELEPORT) {
+        ret = setOf(CASTLE_DRACULA);
+    } else {
+        // HIDE and the double backs are handled by whoever's asking
+        ret = reach;
+    }
+
+    // only a teleport can leave him where he was
+    if(move != TELEPORT) {
+        setRemove(&ret, from);
+    }
+    return ret;
+}
+
+// Fills w with the model's chance of each of the options from 'from',
+// adding up to 1; returns FALSE if there's no way to go
+static int moveWeights(DracDist d, LocationID from, LocationSet options,
+                       double w[NUM_MAP_LOCATIONS])
+{
+    double total = 0;
+    LocationID v;
+    for(v = setNext(options, 0); v != NOWHERE; v = setNext(options, v+1)) {
+        w[v] = d->model(from, v, d->modelData);
+        total += w[v];
+    }
+
+    if(total > 0) {
+        for(v = setNext(options, 0); v != NOWHERE;
+            v = setNext(options, v+1)) {
+            w[v] /= total;
+        }
+    }
+    return (total > 0);
+}
+
+// Spreads the weight evenly over where
+static void spread(double *into, LocationSet where)
+{
+    int n = setSize(where);
+    LocationID v;
+    for(v = 0; v < NUM_MAP_LOCATIONS; v++) {
+        into[v] = setHas(where, v) ? 1.0 / n : 0;
+    }
+}
+
+// Takes away the weight anywhere but where, and scales the rest back up
+static void keepOnly(DracDist d, double *w, LocationSet where)
+{
+    double total = 0;
+    LocationID v;
+    for(v = 0; v < NUM_MAP_LOCATIONS; v++) {
+        if(!setHas(where, v)) {
+            w[v] = 0;
+        }
+        total += w[v];
+    }
+
+    if(total > 0) {
+        for(v = 0; v < NUM_MAP_LOCATIONS; v++) {
+            w[v] /= total;
+        }
+    } else {
+        // the model gave no weight to anywhere he can be
+        spread(w, where);
+    }
+}
+
+// Moves the exact weights on by one of Dracula's moves
+static void exactDraculaPlay(DracDist d, LocationID move, LocationSet mightBe)
+{
+    int i;
+    for(i = TRAIL_SIZE-1; i > 0; i--) {
+        memcpy(d->weights[i], d->weights[i-1], sizeof(d->weights[i]));
+    }
+    double *now = d->weights[0];
+    const double *before = d->weights[1];
+    memset(now, 0, sizeof(d->weights[0]));
+
+    if(d->numKnown == 0) {
+        // no idea where he started
+        spread(now, mightBe);
+    } else {
+        Map map = getMap();
+        int back = move - DOUBLE_BACK_FIRST + 1;
+
+        double w[NUM_MAP_LOCATIONS];
+        LocationID from;
+        for(from = 0; from < NUM_MAP_LOCATIONS; from++) {
+            if(before[from] > 0) {
+                if(move == HIDE || move == DOUBLE_BACK_FIRST) {
+                    // staying where he is
+                    now[from] += before[from];
+                } else if(DOUBLE_BACK_FIRST <= move &&
+                          move <= DOUBLE_BACK_LAST && back <= d->numKnown) {
+                    // back to where he was then, if it's next door; (we
+                    // only know how likely each place was, not which
+                    // trails go with which, so this is near enough)
+                    LocationSet reach =
+                        draculaMoveSet(map, from, DRACULA_MOVES);
+                    const double *then = d->weights[back];
+                    double total = 0;
+                    LocationID v;
+                    for(v = setNext(reach, 0); v != NOWHERE;
+                        v = setNext(reach, v+1)) {
+                        total += then[v];
+                    }
+                    for(v = setNext(reach, 0); v != NOWHERE && total > 0;
+                        v = setNext(reach, v+1)) {
+                        now[v] += before[from] * then[v] / total;
+                    }
+                } else {
+                    // somewhere new, as the model says
+                    LocationSet options =
+                        legalMoves(from, move, setEmpty());
+                    if(moveWeights(d, from, options, w) == TRUE) {
+                        LocationID v;
+                        for(v = setNext(options, 0); v != NOWHERE;
+                            v = setNext(options, v+1)) {
+                            now[v] += before[from] * w[v];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    keepOnly(d, now, mightBe);
+}
+
+// Moves one particle on by one of Dracula's moves; returns where it went,
+// or NOWHERE if this particle couldn't have made that move
+static LocationID moveParticle(DracDist d, Particle *p, LocationID move)
+{
+    LocationID from = p->trail[0];
+    LocationID to = NOWHERE;
+
+    if(move == HIDE) {
+        if(idToType(from) != SEA) {
+            to = from;
+        }
+    } else if(DOUBLE_BACK_FIRST <= move && move <= DOUBLE_BACK_LAST) {
+        LocationID then = p->trail[move - DOUBLE_BACK_FIRST];
+        if(validPlace(then) &&
+           setHas(draculaMoveSet(getMap(), from, DRACULA_MOVES), then)) {
+            to = then;
+        }
+    } else {
+        // anywhere not in this particle's trail (the oldest place is
+        // about to drop off, so he can go there)
+        LocationSet avoid = setEmpty();
+        int i;
+        for(i = 0; i < TRAIL_SIZE-1; i++) {
+            if(validPlace(p->trail[i])) {
+                setAdd(&avoid, p->trail[i]);
+            }
+        }
+
+        LocationSet options = legalMoves(from, move, avoid);
+        double w[NUM_MAP_LOCATIONS];
+        if(moveWeights(d, from, options, w) == TRUE) {
+            double x = randomUnit(&d->rng);
+            LocationID v;
+            for(v = setNext(options, 0); v != NOWHERE && to == NOWHERE;
+                v = setNext(options, v+1)) {
+                x -= w[v];
+                if(x < 0) {
+                    to = v;
+                }
+            }
+            if(to == NOWHERE) {
+                // rounding; take the last one
+                LocationID v = NOWHERE;
+                LocationID next;
+                for(next = setNext(options, 0); next != NOWHERE;
+                    next = setNext(options, next+1)) {
+                    if(w[next] > 0) {
+                        v = next;
+                    }
+                }
+                to = v;
+            }
+        }
+    }
+    return to;
+}
+
+// Moves every particle on by one of Dracula's moves
+static void particlePlay(DracDist d, LocationID move, LocationSet mightBe)
+{
+    int i, j;
+    for(i = 0; i < d->numParticles; i++) {
+        Particle *p = &d->particles[i];
+
+        LocationID to;
+        if(d->numKnown == 0) {
+            to = NOWHERE;
+        } else {
+            to = moveParticle(d, p, move);
+        }
+
+        for(j = TRAIL_SIZE-1; j > 0; j--) {
+            p->trail[j] = p->trail[j-1];
+        }
+        p->trail[0] = to;
+    }
+
+    resample(d, mightBe);
+}
+
+// Replaces every particle that's somewhere he can't be with a copy of one
+// that isn't, picked at random; starts again if none of them are left
+static void resample(DracDist d, LocationSet mightBe)
+{
+    int numAlive = 0;
+    int i;
+    for(i = 0; i < d->numParticles; i++) {
+        LocationID at = d->particles[i].trail[0];
+        if(validPlace(at) && setHas(mightBe, at)) {
+            d->spare[numAlive++] = d->particles[i];
+        }
+    }
+
+    if(numAlive == d->numParticles) {
+        // nothing to do
+    } else if(numAlive > 0) {
+        for(i = 0; i < d->numParticles; i++) {
+            d->particles[i] = d->spare[randomBelow(&d->rng, numAlive)];
+        }
+    } else {
+        // none of them fit; all we know is where he might be now
+        int n = setSize(mightBe);
+        for(i = 0; i < d->numParticles; i++) {
+            Particle *p = &d->particles[i];
+            memset(p->trail, NOWHERE, sizeof(p->trail));
+
+            int k = randomBelow(&d->rng, n);
+            LocationID v = setNext(mightBe, 0);
+            while(k-- > 0) {
+                v = setNext(mightBe, v+1);
+            }
+            p->trail[0] = v;
+        }
+    }
+}
+
+// Works out how likely he is to be at each place now, in either mode
+static void summarise(DracDist d)
+{
+    LocationID v;
+    if(d->numParticles == DIST_EXACT) {
+        memcpy(d->now, d->weights[0], sizeof(d->now));
+    } else {
+        memset(d->now, 0, sizeof(d->now));
+        if(d->numKnown > 0) {
+            int i;
+            for(i = 0; i < d->numParticles; i++) {
+                d->now[(int)d->particles[i].trail[0]] +=
+                    1.0 / d->numParticles;
+            }
+        }
+    }
+
+    double total = 0;
+    for(v = 0; v < NUM_MAP_LOCATIONS; v++) {
+        total += d->now[v];
+        d->cumulative[v] = total;
+    }
+}
@@ -0,0 +1,70 @@
+// DracDist.h ... how likely Dracula is to be at each location
+// Goes a step further than DracBelief: instead of just where he might be,
+// keeps a probability for each place, either exactly (a weight for every
+// location) or by following a number of particles, each a guess at his
+// whole trail. Either way it moves with a pluggable model of how Dracula
+// picks his moves, and is cut down by the same evidence as the belief
+
+#ifndef DRAC_DIST_H
+#define DRAC_DIST_H
+
+#include <stdint.h>
+#include "Globals.h"
+#include "Places.h"
+#include "LocationSet.h"
+#include "PlayDecoder.h"
+#include "DracBelief.h"
+#include "Random.h"
+
+typedef struct dracDist *DracDist;
+
+// numParticles for an exact weight per location rather than particles
+#define DIST_EXACT 0
+
+// A model of how Dracula moves: how likely he is to go from 'from' to 'to'
+//   (which is always somewhere he could legally go), relative to the
+//   other places he could go; data is whatever was given to newDracDist()
+// Must return a weight >= 0
+
+typedef double (*DracMoveModel)(LocationID from, LocationID to, void *data);
+
+// uniformMoveModel() says he's equally likely to go anywhere he can
+
+double uniformMoveModel(LocationID from, LocationID to, void *data);
+
+// newDracDist() starts a distribution with no plays seen
+// numParticles is DIST_EXACT or how many particles to follow
+// model is how Dracula moves (NULL for uniformMoveModel), and modelData
+//   is passed to it each time
+// seed starts the generator particles are moved with, so the same plays
+//   always give the same distribution
+
+DracDist newDracDist(int numParticles, DracMoveModel model, void *modelData,
+                     uint64_t seed);
+
+// disposeDracDist() frees all memory allocated for toBeDeleted
+
+void disposeDracDist(DracDist toBeDeleted);
+
+// updateDist() takes the next play of the game, in order, every player's
+//   included; belief must already have been updated with the same play,
+//   and anywhere it rules out gets no weight
+
+void updateDist(DracDist d, const PlayRecord *play, DracBelief belief);
+
+// distProbability() gives the probability Dracula is at where now
+
+double distProbability(DracDist d, LocationID where);
+
+// distTopK() puts the (up to) k most likely places for Dracula into
+//   locs[], most likely first, and returns how many there were
+// Places with no chance at all are left out
+
+int distTopK(DracDist d, int k, LocationID locs[]);
+
+// distSample() picks a place for Dracula at random, as likely as the
+//   distribution says; NOWHERE if he hasn't moved yet
+
+LocationID distSample(DracDist d, RandomState *rng);
+
+#endif
@@ -0,0 +1,504 @@
+// DracMcts.c ... DracMcts ADT implementation
+// Each playout goes down the tree by UCT, adds one node's children at the
+// bottom, plays on for a few rounds (see Playout.h), and takes the result
+// back up
+// With more than one thread, each grows a tree of its own (root
+// parallelism). They play in batches: everyone runs their share of a
+// batch, then the roots' statistics are added up to choose the move to
+// offer. Nothing is shared while the trees grow, so no locks are needed,
+// and a batch always ends in the same place for the same seed
+// There's no transposition table here, as there is in TreeMcts.c: a table
+// for each thread, judging moves position by position as that does, cost
+// a quarter of the playouts and Dracula played no better for it
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include "Globals.h"
+#include "Game.h"
+#include "Places.h"
+#include "GameState.h"
+#include "Anytime.h"
+#include "Random.h"
+#include "Playout.h"
+#include "Workers.h"
+#include "DracMcts.h"
+
+#define NUM_HUNTERS (NUM_PLAYERS - 1)
+
+// the kinds of move a hunter picks from in the tree: stay and rest, the
+// move that gets closest to Dracula, or the next closest
+#define NUM_ARMS 3
+#define ARM_REST 0
+#define ARM_CHASE 1
+#define ARM_FLANK 2
+#define NO_ARM NUM_ARMS
+
+#define MSECS_PER_SEC 1000.0
+
+#define ROOT 0
+#define NO_NODE -1
+
+// how far down the tree a playout can go, in rounds
+#define MAX_TREE_DEPTH 64
+
+// how many rounds a playout goes on for once it leaves the tree
+#define ROLLOUT_ROUNDS 10
+
+// UCT's exploration constant, for rewards in [0, 1]
+#define EXPLORATION 0.7
+
+// how often, in playouts, to look at the clock, and how many playouts
+// each thread runs between offers of the best move
+#define PLAYOUTS_PER_CHECK 256
+#define PLAYOUTS_PER_OFFER 4096
+
+// no limit on how many playouts a thread runs
+#define NO_LIMIT -1
+
+typedef struct node {
+    // how many playouts came through here, and Dracula's total reward
+    int visits;
+    float value;
+
+    // the children are numChildren nodes in a row, NO_NODE until the node
+    // is expanded; move is Dracula's move that leads here
+    int firstChild;
+    unsigned char numChildren;
+    signed char move;
+
+    // each hunter's statistics for their reply to move (their reward is
+    // one less Dracula's)
+    int hunterVisits[NUM_HUNTERS][NUM_ARMS];
+    float hunterValue[NUM_HUNTERS][NUM_ARMS];
+} Node;
+
+// one thread's tree, and its own random numbers
+typedef struct tree {
+    Node *nodes;
+    int maxNodes;
+    int numNodes;
+
+    RandomState rng;
+
+    long long playouts;
+    long long positions;
+
+    // how many playouts this thread has left, and how many of them to run
+    // in this batch
+    long long left;
+    int batch;
+} Tree;
+
+struct dracMcts {
+    Tree *trees;
+    int numTrees;
+    Workers workers;
+
+    uint64_t seed;
+
+    // the search in progress, for the threads
+    const GameState *root;
+    Anytime clock;
+};
+
+static void runBatch(int worker, void *data);
+static void newNode(Tree *t, int n, LocationID move);
+static void playout(Tree *t, const GameState *root);
+static int expand(Tree *t, int n, const GameState *s);
+static int selectChild(Tree *t, int n);
+static int selectArm(const Node *node, PlayerID hunter);
+static LocationID armMove(const GameState *s, PlayerID hunter, int arm);
+static int bestChild(DracMcts m, int *visits);
+static void report(DracMcts m, Anytime clock, PlayerMessage message);
+
+// Makes a search on numThreads threads, with room for maxNodes nodes
+DracMcts newDracMcts(int maxNodes, int numThreads, uint64_t seed)
+{
+    assert(numThreads > 0);
+    assert(maxNodes / numThreads > MAX_STATE_MOVES);
+
+    DracMcts m = malloc(sizeof(struct dracMcts));
+    assert(m != NULL);
+    m->workers = newWorkers(numThreads);
+    m->numTrees = numWorkers(m->workers);
+    m->trees = malloc(m->numTrees * sizeof(Tree));
+    assert(m->trees != NULL);
+
+    int i;
+    for(i = 0; i < m->numTrees; i++) {
+        Tree *t = &m->trees[i];
+        t->maxNodes = maxNodes / m->numTrees;
+        t->nodes = malloc(t->maxNodes * sizeof(Node));
+        assert(t->nodes != NULL);
+        t->numNodes = 0;
+        t->playouts = 0;
+        t->positions = 0;
+    }
+    m->seed = seed;
+    m->root = NULL;
+    m->clock = NULL;
+
+    return m;
+}
+
+// Frees all memory allocated for toBeDeleted
+void disposeDracMcts(DracMcts toBeDeleted)
+{
+    assert(toBeDeleted != NULL);
+    disposeWorkers(toBeDeleted->workers);
+    int i;
+    for(i = 0; i < toBeDeleted->numTrees; i++) {
+        free(toBeDeleted->trees[i].nodes);
+    }
+    free(toBeDeleted->trees);
+    free(toBeDeleted);
+}
+
+// Searches from root until the time's up
+LocationID searchMcts(DracMcts m, const GameState *root, Anytime clock,
+                      long long maxPlayouts)
+{
+    assert(m != NULL);
+    assert(root != NULL && root->player == PLAYER_DRACULA);
+    assert(clock != NULL);
+
+    m->root = root;
+    m->clock = clock;
+
+    // each thread's random numbers start from the next of the seed's own,
+    // so they're well apart; the playouts are shared out as evenly as
+    // they go
+    RandomState seeds;
+    seedRandom(&seeds, m->seed);
+    int i;
+    for(i = 0; i < m->numTrees; i++) {
+        Tree *t = &m->trees[i];
+        seedRandom(&t->rng, nextRandom(&seeds));
+        t->playouts = 0;
+        t->positions = 0;
+        t->left = NO_LIMIT;
+        if(maxPlayouts > 0) {
+            t->left = maxPlayouts / m->numTrees +
+                      (i < maxPlayouts % m->numTrees);
+        }
+        t->numNodes = 1;
+        newNode(t, ROOT, NOWHERE);
+        expand(t, ROOT, root);
+    }
+
+    LocationID move = NOWHERE;
+    int more = TRUE;
+    while(more) {
+        more = FALSE;
+        for(i = 0; i < m->numTrees; i++) {
+            Tree *t = &m->trees[i];
+            t->batch = PLAYOUTS_PER_OFFER;
+            if(t->left != NO_LIMIT && t->left < t->batch) {
+                t->batch = t->left;
+            }
+            if(t->batch > 0) {
+                more = TRUE;
+            }
+        }
+
+        if(more) {
+            runWorkers(m->workers, runBatch, m);
+
+            int visits;
+            int best = bestChild(m, &visits);
+            move = m->trees[0].nodes[best].move;
+            PlayerMessage message;
+            report(m, clock, message);
+            offerMove(clock, move, 1, visits, message);
+            more = !timeIsUp(clock);
+        }
+    }
+
+    PlayerMessage message;
+    report(m, clock, message);
+    restateMove(clock, message);
+
+    m->root = NULL;
+    m->clock = NULL;
+    return move;
+}
+
+// How many playouts the last search ran
+long long mctsPlayouts(DracMcts m)
+{
+    assert(m != NULL);
+    long long playouts = 0;
+    int i;
+    for(i = 0; i < m->numTrees; i++) {
+        playouts += m->trees[i].playouts;
+    }
+    return playouts;
+}
+
+// How many positions the last search went through
+long long mctsNodes(DracMcts m)
+{
+    assert(m != NULL);
+    long long positions = 0;
+    int i;
+    for(i = 0; i < m->numTrees; i++) {
+        positions += m->trees[i].positions;
+    }
+    return positions;
+}
+
+// How big the last search's trees were
+int mctsTreeSize(DracMcts m)
+{
+    assert(m != NULL);
+    int size = 0;
+    int i;
+    for(i = 0; i < m->numTrees; i++) {
+        size += m->trees[i].numNodes;
+    }
+    return size;
+}
+
+// How many threads the search runs on
+int mctsThreads(DracMcts m)
+{
+    assert(m != NULL);
+    return m->numTrees;
+}
+
+// One thread's share of a batch: its playouts, unless the time's up
+static void runBatch(int worker, void *data)
+{
+    DracMcts m = data;
+    Tree *t = &m->trees[worker];
+
+    int i = 0;
+    while(i < t->batch) {
+        playout(t, m->root);
+        t->playouts++;
+        i++;
+        if(i % PLAYOUTS_PER_CHECK == 0 && timeIsUp(m->clock)) {
+            t->batch = i;
+        }
+    }
+    if(t->left != NO_LIMIT) {
+        t->left -= i;
+    }
+}
+
+// Sets up node n, reached by move
+static void newNode(Tree *t, int n, LocationID move)
+{
+    Node *node = &t->nodes[n];
+    node->visits = 0;
+    node->value = 0;
+    node->firstChild = NO_NODE;
+    node->numChildren = 0;
+    node->move = move;
+
+    int h, a;
+    for(h = 0; h < NUM_HUNTERS; h++) {
+        for(a = 0; a < NUM_ARMS; a++) {
+            node->hunterVisits[h][a] = 0;
+            node->hunterValue[h][a] = 0;
+        }
+    }
+}
+
+// One playout: down the tree, on at random, and back up
+static void playout(Tree *t, const GameState *root)
+{
+    GameState s = *root;
+
+    // the nodes we went through, and the hunters' replies at each
+    int path[MAX_TREE_DEPTH + 1];
+    unsigned char arms[MAX_TREE_DEPTH + 1][NUM_HUNTERS];
+    int depth = 0;
+
+    int n = ROOT;
+    path[depth++] = n;
+    int descending = TRUE;
+    while(descending && !isGameOver(&s) && depth <= MAX_TREE_DEPTH) {
+        // only give a node children once it's been played out from
+        if(t->nodes[n].firstChild == NO_NODE &&
+           (t->nodes[n].visits == 0 || !expand(t, n, &s))) {
+            descending = FALSE;
+        } else {
+            n = selectChild(t, n);
+            applyMove(&s, t->nodes[n].move);
+            t->positions++;
+
+            PlayerID h;
+            for(h = 0; h < NUM_HUNTERS; h++) {
+                arms[depth][h] = NO_ARM;
+                if(!isGameOver(&s)) {
+                    int arm = selectArm(&t->nodes[n], h);
+                    applyMove(&s, armMove(&s, h, arm));
+                    t->positions++;
+                    arms[depth][h] = arm;
+                }
+            }
+            path[depth++] = n;
+        }
+    }
+
+    t->positions += playOut(&s, &t->rng, ROLLOUT_ROUNDS);
+    double r = draculaReward(&s);
+
+    int i;
+    for(i = 0; i < depth; i++) {
+        Node *node = &t->nodes[path[i]];
+        node->visits++;
+        node->value += r;
+
+        PlayerID h;
+        for(h = 0; h < NUM_HUNTERS && i > 0; h++) {
+            int arm = arms[i][h];
+            if(arm != NO_ARM) {
+                node->hunterVisits[h][arm]++;
+                node->hunterValue[h][arm] += 1 - r;
+            }
+        }
+    }
+}
+
+// Gives node n a child for each move Dracula can make from s, if there's
+// room; TRUE if there was
+// Dracula's moves only depend on his own trail, so they're the same
+// every time a playout gets here
+static int expand(Tree *t, int n, const GameState *s)
+{
+    LocationID moves[MAX_STATE_MOVES];
+    LocationID dests[MAX_STATE_MOVES];
+    int numMoves = draculaMoves(s, moves, dests);
+
+    int ok = (t->numNodes + numMoves <= t->maxNodes);
+    if(ok) {
+        t->nodes[n].firstChild = t->numNodes;
+        t->nodes[n].numChildren = numMoves;
+
+        int i;
+        for(i = 0; i < numMoves; i++) {
+            newNode(t, t->numNodes, moves[i]);
+            t->numNodes++;
+        }
+    }
+    return ok;
+}
+
+// UCT: the child with the best upper confidence bound
+static int selectChild(Tree *t, int n)
+{
+    const Node *node = &t->nodes[n];
+    double logVisits = log(node->visits + 1);
+
+    // any that haven't been tried come first
+    int best = NO_NODE;
+    int c;
+    for(c = node->firstChild;
+        c < node->firstChild + node->numChildren && best == NO_NODE; c++) {
+        if(t->nodes[c].visits == 0) {
+            best = c;
+        }
+    }
+
+    if(best == NO_NODE) {
+        double bestBound = 0;
+        for(c = node->firstChild; c < node->firstChild + node->numChildren;
+            c++) {
+            const Node *child = &t->nodes[c];
+            double bound = child->value / child->visits +
+                           EXPLORATION * sqrt(logVisits / child->visits);
+            if(best == NO_NODE || bound > bestBound) {
+                best = c;
+                bestBound = bound;
+            }
+        }
+    }
+    return best;
+}
+
+// Decoupled UCT: the hunter's own choice of arm, on their own statistics
+static int selectArm(const Node *node, PlayerID hunter)
+{
+    int total = 0;
+    int a;
+    for(a = 0; a < NUM_ARMS; a++) {
+        total += node->hunterVisits[hunter][a];
+    }
+    double logVisits = log(total + 1);
+
+    // any they haven't tried come first
+    int best = NO_ARM;
+    for(a = 0; a < NUM_ARMS && best == NO_ARM; a++) {
+        if(node->hunterVisits[hunter][a] == 0) {
+            best = a;
+        }
+    }
+
+    if(best == NO_ARM) {
+        double bestBound = 0;
+        for(a = 0; a < NUM_ARMS; a++) {
+            int visits = node->hunterVisits[hunter][a];
+            double bound = node->hunterValue[hunter][a] / visits +
+                           EXPLORATION * sqrt(logVisits / visits);
+            if(best == NO_ARM || bound > bestBound) {
+                best = a;
+                bestBound = bound;
+            }
+        }
+    }
+    return best;
+}
+
+// The place an arm takes a hunter to
+static LocationID armMove(const GameState *s, PlayerID hunter, int arm)
+{
+    LocationID move = s->location[hunter];
+    if(arm != ARM_REST) {
+        LocationID flank;
+        LocationID chase = chaseMove(s, hunter, s->location[PLAYER_DRACULA],
+                                     &flank);
+        move = (arm == ARM_CHASE) ? chase : flank;
+    }
+    return move;
+}
+
+// The root's most tried child, counting every tree's tries, and how many
+// tries that was
+// Every tree's root has the same children in the same order, since they
+// all come from the same position
+static int bestChild(DracMcts m, int *visits)
+{
+    const Node *root = &m->trees[0].nodes[ROOT];
+    int best = NO_NODE;
+    int bestVisits = 0;
+    int c;
+    for(c = root->firstChild; c < root->firstChild + root->numChildren;
+        c++) {
+        int total = 0;
+        int i;
+        for(i = 0; i < m->numTrees; i++) {
+            total += m->trees[i].nodes[c].visits;
+        }
+        if(best == NO_NODE || total > bestVisits) {
+            best = c;
+            bestVisits = total;
+        }
+    }
+
+    (*visits) = bestVisits;
+    return best;
+}
+
+// How the search is going, as a message
+static void report(DracMcts m, Anytime clock, PlayerMessage message)
+{
+    double secs = msecsUsed(clock) / MSECS_PER_SEC;
+    snprintf(message, MESSAGE_SIZE,
+             "%lld playouts on %d threads, %.0f nodes/sec",
+             mctsPlayouts(m), m->numTrees,
+             (secs > 0) ? mctsNodes(m) / secs : 0);
+}
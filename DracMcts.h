@@ -0,0 +1,62 @@
+// DracMcts.h ... Monte Carlo tree search for Dracula's move
+// The tree is over Dracula's move codes (places, HIDE, DOUBLE_BACK_N,
+// TELEPORT), selected by UCT. It's open loop: a node stands for a sequence
+// of Dracula's moves, not a position. The hunters move all at once after
+// him, each picking from a few kinds of move with statistics of their own
+// at every node (decoupled UCT), so they play against him in the tree.
+// Every playout runs on a GameState, and nodes come from a pool allocated
+// once, so a search allocates nothing
+// It can run on several threads, each growing a tree of its own, whose
+// roots are added together to choose the move
+
+#ifndef DRAC_MCTS_H
+#define DRAC_MCTS_H
+
+#include <stdint.h>
+#include "Globals.h"
+#include "Places.h"
+#include "GameState.h"
+#include "Anytime.h"
+
+typedef struct dracMcts *DracMcts;
+
+// newDracMcts() makes a search on numThreads threads, with room for
+//   maxNodes tree nodes shared out between them
+// seed starts the random numbers, so the same position searched for the
+//   same number of playouts on the same number of threads always gives
+//   the same move
+
+DracMcts newDracMcts(int maxNodes, int numThreads, uint64_t seed);
+
+// disposeDracMcts() frees all memory allocated for toBeDeleted
+
+void disposeDracMcts(DracMcts toBeDeleted);
+
+// searchMcts() searches from root, where it must be Dracula's turn, until
+//   clock's time is up or maxPlayouts playouts have been run (0 for no
+//   limit), offering its best move to clock every so often
+// Starts a new tree every time
+// Returns the best move: the one most often tried from root
+
+LocationID searchMcts(DracMcts m, const GameState *root, Anytime clock,
+                      long long maxPlayouts);
+
+// mctsPlayouts() gives how many playouts the last search ran
+
+long long mctsPlayouts(DracMcts m);
+
+// mctsNodes() gives how many positions the last search went through, in
+//   the tree and in the playouts together
+
+long long mctsNodes(DracMcts m);
+
+// mctsTreeSize() gives how many nodes the last search's trees had
+
+int mctsTreeSize(DracMcts m);
+
+// mctsThreads() gives how many threads the search runs on (fewer than
+//   asked for if the system wouldn't start them all)
+
+int mctsThreads(DracMcts m);
+
+#endif
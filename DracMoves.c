@@ -0,0 +1,129 @@
+// DracMoves.c ... working out Dracula's moves from his trail
+// The places are his reach from where he is, less the places still in his
+// trail: a couple of set operations. The rest are one bit each
+
+#include <stdlib.h>
+#include <assert.h>
+#include "Globals.h"
+#include "Places.h"
+#include "Map.h"
+#include "LocationSet.h"
+#include "GameState.h"
+#include "DracMoves.h"
+
+// first and last double back
+#define DOUBLE_BACK_FIRST DOUBLE_BACK_1
+#define DOUBLE_BACK_LAST DOUBLE_BACK_5
+
+// Every move Dracula can make from s
+DracMoves draculaMoveMask(const GameState *s, int flags)
+{
+    assert(s != NULL);
+
+    DracMoves m;
+    m.places = setEmpty();
+    m.specials = 0;
+    int i;
+    for(i = 0; i < TRAIL_SIZE - 1; i++) {
+        m.back[i] = s->trail[i];
+    }
+
+    LocationID here = s->trail[0];
+    if(here == NOWHERE) {
+        // his first move: anywhere but the hospital
+        m.places = setAll();
+        setRemove(&m.places, ST_JOSEPH_AND_ST_MARYS);
+    } else {
+        // his last TRAIL_SIZE-1 moves, and where they took him, stay in
+        // the trail after this one
+        int hasHide = FALSE;
+        int hasDoubleBack = FALSE;
+        LocationSet kept = setEmpty();
+        for(i = 0; i < TRAIL_SIZE - 1; i++) {
+            if(s->moves[i] == HIDE) {
+                hasHide = TRUE;
+            } else if(DOUBLE_BACK_FIRST <= s->moves[i] &&
+                      s->moves[i] <= DOUBLE_BACK_LAST) {
+                hasDoubleBack = TRUE;
+            }
+            if(validPlace(s->trail[i])) {
+                setAdd(&kept, s->trail[i]);
+            }
+        }
+
+        LocationSet reach = draculaMoveSet(getMap(), here, flags);
+        m.places = setMinus(reach, kept);
+
+        if(!hasHide && idToType(here) != SEA) {
+            m.specials |= SPECIAL_BIT(HIDE);
+        }
+        // DOUBLE_BACK_1 is to here, which is always in reach
+        for(i = 0; i < TRAIL_SIZE - 1 && !hasDoubleBack; i++) {
+            if(validPlace(s->trail[i]) && setHas(reach, s->trail[i])) {
+                m.specials |= SPECIAL_BIT(DOUBLE_BACK_FIRST + i);
+            }
+        }
+    }
+
+    // nowhere to go: back to the castle
+    if(setIsEmpty(m.places) && m.specials == 0) {
+        m.specials = SPECIAL_BIT(TELEPORT);
+    }
+    return m;
+}
+
+// Where move takes Dracula
+LocationID dracMoveTo(const DracMoves *moves, LocationID move)
+{
+    assert(moves != NULL);
+    assert(isLegalDraculaMove(moves, move));
+
+    LocationID to = move;
+    if(move == HIDE) {
+        to = moves->back[0];
+    } else if(DOUBLE_BACK_FIRST <= move && move <= DOUBLE_BACK_LAST) {
+        to = moves->back[move - DOUBLE_BACK_FIRST];
+    } else if(move == TELEPORT) {
+        to = CASTLE_DRACULA;
+    }
+    return to;
+}
+
+// Every one of the moves, and where each one goes
+int listDracMoves(const DracMoves *moves, LocationID list[],
+                  LocationID dests[])
+{
+    assert(moves != NULL);
+    assert(list != NULL && dests != NULL);
+
+    int n = setToArray(moves->places, list);
+    int i;
+    for(i = 0; i < n; i++) {
+        dests[i] = list[i];
+    }
+
+    LocationID move;
+    for(move = HIDE; move <= TELEPORT; move++) {
+        if(moves->specials & SPECIAL_BIT(move)) {
+            list[n] = move;
+            dests[n] = dracMoveTo(moves, move);
+            n++;
+        }
+    }
+    return n;
+}
+
+// Everywhere the moves go
+LocationSet dracMoveDests(const DracMoves *moves)
+{
+    assert(moves != NULL);
+
+    LocationSet dests = moves->places;
+    LocationID move;
+    for(move = HIDE; move <= TELEPORT; move++) {
+        if(moves->specials & SPECIAL_BIT(move)) {
+            setAdd(&dests, dracMoveTo(moves, move));
+        }
+    }
+    return dests;
+}
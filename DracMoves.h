@@ -0,0 +1,66 @@
+// DracMoves.h ... every move Dracula can make, worked out once
+// His moves depend only on where he is and what's in his trail, so they're
+// worked out from the trail in one go: the places he can move straight to
+// as a LocationSet, and the moves that aren't places (HIDE, DOUBLE_BACK_N
+// and TELEPORT) as bits. After that, checking a move is a bit test and
+// listing them all is a walk over the bits, with nothing allocated
+
+#ifndef DRAC_MOVES_H
+#define DRAC_MOVES_H
+
+#include "Globals.h"
+#include "Places.h"
+#include "LocationSet.h"
+#include "GameState.h"
+
+// a move that isn't a place, HIDE to TELEPORT, as its bit in specials
+#define SPECIAL_BIT(move) (1 << ((move) - HIDE))
+
+typedef struct dracMoves {
+    LocationSet places;               // places he can move straight to
+    unsigned char specials;           // SPECIAL_BIT()s of the rest
+    signed char back[TRAIL_SIZE - 1]; // where HIDE (back[0]) and each
+                                      //   DOUBLE_BACK_N (back[N-1]) take
+                                      //   him, whether or not he can
+} DracMoves;
+
+// draculaMoveMask() works out every move Dracula can make from s, which
+//   needn't be his turn, by road and/or sea as flags gives them
+//   (MOVE_ROAD | MOVE_SEA, as in Map.h)
+// Follows the rules: anywhere but the hospital on his first move; no
+//   place that's still in his trail, except by HIDE (not at sea) or
+//   DOUBLE_BACK_N, and only one of each in the trail at a time; TELEPORT
+//   only if there's nothing else
+
+DracMoves draculaMoveMask(const GameState *s, int flags);
+
+// isLegalDraculaMove() is TRUE if move is one of moves'
+
+static inline int isLegalDraculaMove(const DracMoves *moves, LocationID move)
+{
+    int legal = FALSE;
+    if(validPlace(move)) {
+        legal = setHas(moves->places, move);
+    } else if(HIDE <= move && move <= TELEPORT) {
+        legal = (moves->specials & SPECIAL_BIT(move)) != 0;
+    }
+    return legal;
+}
+
+// dracMoveTo() gives where move takes Dracula; move must be one of moves'
+
+LocationID dracMoveTo(const DracMoves *moves, LocationID move);
+
+// listDracMoves() puts every one of moves' moves into list (places in id
+//   order, then HIDE, DOUBLE_BACK_1 to 5 and TELEPORT), and where each one
+//   takes him into dests; returns how many there are
+// Both arrays must have room for MAX_STATE_MOVES
+
+int listDracMoves(const DracMoves *moves, LocationID list[],
+                  LocationID dests[]);
+
+// dracMoveDests() gives every place one of moves' moves takes him to
+
+LocationSet dracMoveDests(const DracMoves *moves);
+
+#endif
@@ -9,6 +9,8 @@
 #include "Game.h"
 #include "Places.h"
 #include "GameView.h"
+#include "LocationSet.h"
+#include "DracMoves.h"
 
 typedef struct dracView *DracView;
 
@@ -32,6 +34,20 @@ typedef struct dracView *DracView;
 
 DracView newDracView(char *pastPlays, PlayerMessage messages[]);
 
+// newDracViewBorrowed() reads pastPlays and messages in place instead of
+// copying them; the caller must keep both alive and unchanged until the
+// view is disposed of (see newGameViewBorrowed() in GameView.h)
+
+DracView newDracViewBorrowed(char *pastPlays, PlayerMessage messages[]);
+
+
+// appendDracPlay() brings an existing DracView up to date with one more
+// play, without reparsing the plays it has already seen
+// (see appendPlay() in GameView.h)
+
+void appendDracPlay(DracView currentView, const char *play,
+                    PlayerMessage message);
+
 
 // disposeDracView() frees all memory previously allocated for the DracView
 // toBeDeleted. toBeDeleted should not be accessed after the call.
@@ -100,6 +116,18 @@ void whatsThere(DracView currentView, LocationID where,
 void giveMeTheTrail(DracView currentView, PlayerID player,
                         LocationID trail[TRAIL_SIZE]);
 
+// whereHaveIBeen() fills trail with where I (Dracula) actually was on each
+//   of my last 6 turns, most recent first: unlike giveMeTheTrail(), HIDE,
+//   DOUBLE_BACK_N and TELEPORT are followed to where they took me
+// Entries before the start of the game are UNKNOWN_LOCATION
+
+void whereHaveIBeen(DracView currentView, LocationID trail[TRAIL_SIZE]);
+
+// giveMeTheState() fills state with the game as it stands, for a search
+//   to play moves on (see GameState.h); everything in it is exact
+
+void giveMeTheState(DracView currentView, GameState *state);
+
 
 //// Functions that query the map to find information about connectivity
 
@@ -116,6 +144,18 @@ void giveMeTheTrail(DracView currentView, PlayerID player,
 
 LocationID *whereCanIgo(DracView currentView, int *numLocations, int road, int sea);
 
+// whereCanIgoSet() gives the same locations as whereCanIgo() as a
+//   LocationSet; nothing is allocated
+
+LocationSet whereCanIgoSet(DracView currentView, int road, int sea);
+
+// whatCanIdo() gives my (Dracula's) next moves as moves rather than
+//   places: which places I can move straight to, and which of HIDE,
+//   DOUBLE_BACK_N and TELEPORT I can make (see DracMoves.h)
+// road and sea are as for whereCanIgo()
+
+DracMoves whatCanIdo(DracView currentView, int road, int sea);
+
 // whereCanTheyGo() returns an array of LocationIDs giving all of the
 //   locations that the given Player could reach from their current location
 // road, rail and sea are connections should only be considered
@@ -131,4 +171,10 @@ LocationID *whereCanIgo(DracView currentView, int *numLocations, int road, int s
 LocationID *whereCanTheyGo(DracView currentView, int *numLocations,
                            PlayerID player, int road, int rail, int sea);
 
+// whereCanTheyGoSet() gives the same locations as whereCanTheyGo() as a
+//   LocationSet; nothing is allocated
+
+LocationSet whereCanTheyGoSet(DracView currentView, PlayerID player,
+                              int road, int rail, int sea);
+
 #endif
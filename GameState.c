@@ -0,0 +1,387 @@
+// GameState.c ... playing moves on a GameState
+// The rules are the ones GameView follows when it reads the plays
+
+#include <stdlib.h>
+#include <assert.h>
+#include "Globals.h"
+#include "Places.h"
+#include "Map.h"
+#include "GameState.h"
+#include "DracMoves.h"
+
+// first and last double back
+#define DOUBLE_BACK_FIRST DOUBLE_BACK_1
+#define DOUBLE_BACK_LAST DOUBLE_BACK_5
+
+// mod that restricts the rail travel of the hunters by the sum of the round
+// and the hunter
+#define RAIL_RESTRICT 4
+
+// what the parts of the key stand for (each part is one thing's value)
+#define KEY_PLAYER 0
+#define KEY_LOCATION 1
+#define KEY_HEALTH 2
+#define KEY_TRAIL 3
+#define KEY_MOVE 4
+#define KEY_TRAPS 5
+#define KEY_VAMPIRE 6
+
+// the trap bit for a trail slot, and every slot's
+#define TRAP_BIT(i) (1 << (i))
+#define ALL_TRAPS (TRAP_BIT(TRAIL_SIZE) - 1)
+
+static void moveDracula(GameState *s, LocationID move);
+static void moveHunter(GameState *s, LocationID to);
+static void unmoveDracula(GameState *s, const GameUndo *undo);
+static PlayerID nextPlayer(PlayerID p);
+static uint64_t moverKey(const GameState *s, PlayerID mover);
+static uint64_t keyOf(int kind, int index, int value);
+static LocationID doubleBackTo(const GameState *s, LocationID move);
+static int encountersAt(const GameState *s, LocationID where);
+static LocationID unknownPlace(LocationID where);
+
+// Every move Dracula can make
+int draculaMoves(const GameState *s, LocationID moves[], LocationID dests[])
+{
+    assert(s != NULL);
+    assert(moves != NULL && dests != NULL);
+
+    DracMoves m = draculaMoveMask(s, MOVE_ROAD | MOVE_SEA);
+    return listDracMoves(&m, moves, dests);
+}
+
+// Everywhere a hunter can go next turn
+const LocationID *hunterMoves(const GameState *s, PlayerID hunter,
+                              int *numMoves)
+{
+    assert(s != NULL);
+    assert(0 <= hunter && hunter < PLAYER_DRACULA);
+    assert(validPlace(s->location[hunter]));
+    assert(numMoves != NULL);
+
+    // if they've had their turn this round, it's next round's rail
+    Round round = s->round + (hunter < s->player);
+    return hunterMoveList(getMap(), s->location[hunter],
+                          (round + hunter) % RAIL_RESTRICT,
+                          MOVE_ROAD | MOVE_SEA, numMoves);
+}
+
+// Plays a move for whoever's turn it is
+void applyMove(GameState *s, LocationID move)
+{
+    assert(s != NULL);
+
+    // the key of everything this move can change, before and after
+    PlayerID mover = s->player;
+    uint64_t before = moverKey(s, mover);
+
+    if(s->player == PLAYER_DRACULA) {
+        moveDracula(s, move);
+        s->round++;
+    } else {
+        moveHunter(s, move);
+    }
+    s->player = nextPlayer(s->player);
+
+    // back on their feet after a turn in hospital, as soon as it's their
+    // turn again (as GameView has it)
+    PlayerID p = s->player;
+    if(s->location[p] == ST_JOSEPH_AND_ST_MARYS && s->health[p] == 0) {
+        s->health[p] = GAME_START_HUNTER_LIFE_POINTS;
+    }
+
+    s->key ^= before ^ moverKey(s, mover);
+}
+
+// Plays a move, keeping what's needed to take it back
+void makeMove(GameState *s, LocationID move, GameUndo *undo)
+{
+    assert(s != NULL);
+    assert(undo != NULL);
+
+    PlayerID p = s->player;
+    undo->key = s->key;
+    undo->health = s->health[p];
+    undo->nextHealth = s->health[nextPlayer(p)];
+    undo->draculaHealth = s->health[PLAYER_DRACULA];
+    undo->score = s->score;
+    undo->location = s->location[p];
+    undo->trail = s->trail[TRAIL_SIZE-1];
+    undo->move = s->moves[TRAIL_SIZE-1];
+    int i;
+    for(i = 0; i < TRAIL_SIZE; i++) {
+        undo->seen[i] = s->seen[i];
+    }
+    undo->traps = s->traps;
+    undo->vampire = s->vampire;
+
+    applyMove(s, move);
+}
+
+// Takes back the last move
+void undoMove(GameState *s, const GameUndo *undo)
+{
+    assert(s != NULL);
+    assert(undo != NULL);
+
+    PlayerID p;
+    if(s->player == PLAYER_LORD_GODALMING) {
+        p = PLAYER_DRACULA;
+        s->round--;
+        unmoveDracula(s, undo);
+    } else {
+        p = s->player - 1;
+    }
+    s->health[s->player] = undo->nextHealth;
+    s->player = p;
+
+    s->health[p] = undo->health;
+    s->health[PLAYER_DRACULA] = undo->draculaHealth;
+    s->score = undo->score;
+    s->location[p] = undo->location;
+    int i;
+    for(i = 0; i < TRAIL_SIZE; i++) {
+        s->seen[i] = undo->seen[i];
+    }
+    s->traps = undo->traps;
+    s->vampire = undo->vampire;
+    s->key = undo->key;
+}
+
+// How many traps are at a place
+int trapsAt(const GameState *s, LocationID where)
+{
+    assert(s != NULL);
+
+    int n = 0;
+    int i;
+    for(i = 0; i < TRAIL_SIZE; i++) {
+        if((s->traps & TRAP_BIT(i)) && s->trail[i] == where) {
+            n++;
+        }
+    }
+    return n;
+}
+
+// Where the immature vampire is
+LocationID vampireLocation(const GameState *s)
+{
+    assert(s != NULL);
+    return (s->vampire == NO_VAMPIRE) ? NOWHERE : s->trail[s->vampire];
+}
+
+// The key from scratch
+uint64_t stateKey(const GameState *s)
+{
+    assert(s != NULL);
+
+    uint64_t key = keyOf(KEY_PLAYER, 0, s->player) ^
+                   keyOf(KEY_TRAPS, 0, s->traps) ^
+                   keyOf(KEY_VAMPIRE, 0, s->vampire);
+    int i;
+    for(i = 0; i < NUM_PLAYERS; i++) {
+        key ^= keyOf(KEY_LOCATION, i, s->location[i]) ^
+               keyOf(KEY_HEALTH, i, s->health[i]);
+    }
+    for(i = 0; i < TRAIL_SIZE; i++) {
+        key ^= keyOf(KEY_TRAIL, i, s->trail[i]) ^
+               keyOf(KEY_MOVE, i, s->moves[i]);
+    }
+    return key;
+}
+
+// Is the game over
+int isGameOver(const GameState *s)
+{
+    assert(s != NULL);
+    return s->health[PLAYER_DRACULA] <= 0 || s->score <= 0;
+}
+
+// Dracula's move: onto his trail, then what the place does to him
+static void moveDracula(GameState *s, LocationID move)
+{
+    LocationID here;
+    if(move == TELEPORT) {
+        here = CASTLE_DRACULA;
+    } else if(move == HIDE) {
+        here = s->trail[0];
+    } else if(DOUBLE_BACK_FIRST <= move && move <= DOUBLE_BACK_LAST) {
+        here = doubleBackTo(s, move);
+    } else {
+        here = move;
+    }
+    assert(validPlace(here));
+
+    // whatever he left with the move that's falling off the trail goes:
+    // a trap just expires, but a vampire matures
+    if(s->vampire == TRAIL_SIZE - 1) {
+        s->score -= SCORE_LOSS_VAMPIRE_MATURES;
+        s->vampire = NO_VAMPIRE;
+    } else if(s->vampire != NO_VAMPIRE) {
+        s->vampire++;
+    }
+    s->traps = (s->traps << 1) & ALL_TRAPS;
+
+    int i;
+    for(i = TRAIL_SIZE - 1; i > 0; i--) {
+        s->trail[i] = s->trail[i-1];
+        s->moves[i] = s->moves[i-1];
+        s->seen[i] = s->seen[i-1];
+    }
+    s->trail[0] = here;
+    s->moves[0] = move;
+    s->location[PLAYER_DRACULA] = here;
+
+    // the hunters see his special moves for what they are, and a place
+    // only if it's the castle or there's a hunter there
+    s->seen[0] = move;
+    if(validPlace(move) && move != CASTLE_DRACULA) {
+        s->seen[0] = unknownPlace(here);
+        PlayerID h;
+        for(h = 0; h < PLAYER_DRACULA; h++) {
+            if(s->location[h] == here) {
+                s->seen[0] = here;
+            }
+        }
+    }
+
+    if(idToType(here) == SEA) {
+        s->health[PLAYER_DRACULA] -= LIFE_LOSS_SEA;
+    } else {
+        if(here == CASTLE_DRACULA) {
+            s->health[PLAYER_DRACULA] += LIFE_GAIN_CASTLE_DRACULA;
+        }
+
+        // leave something nasty behind, if there's room
+        if(encountersAt(s, here) < MAX_ENCOUNTERS) {
+            if(s->round % VAMPIRE_ROUNDS == 0) {
+                s->vampire = 0;
+            } else {
+                s->traps |= TRAP_BIT(0);
+            }
+        }
+    }
+    s->score -= SCORE_LOSS_DRACULA_TURN;
+}
+
+// Takes Dracula's trail back a move; everything else is in undo
+static void unmoveDracula(GameState *s, const GameUndo *undo)
+{
+    int i;
+    for(i = 0; i < TRAIL_SIZE - 1; i++) {
+        s->trail[i] = s->trail[i+1];
+        s->moves[i] = s->moves[i+1];
+    }
+    s->trail[TRAIL_SIZE-1] = undo->trail;
+    s->moves[TRAIL_SIZE-1] = undo->move;
+    s->location[PLAYER_DRACULA] = s->trail[0];
+}
+
+// A hunter's move: running into Dracula, resting, or off to hospital
+static void moveHunter(GameState *s, LocationID to)
+{
+    PlayerID h = s->player;
+    assert(validPlace(to));
+
+    // traps first, then the vampire, then Dracula himself, for as long
+    // as the hunter's still standing; anything of his trail they land on
+    // is revealed, and they clear away whatever they find
+    int i;
+    for(i = 0; i < TRAIL_SIZE; i++) {
+        if(s->trail[i] == to) {
+            if(s->traps & TRAP_BIT(i)) {
+                if(s->health[h] > 0) {
+                    s->health[h] -= LIFE_LOSS_TRAP_ENCOUNTER;
+                }
+                s->traps &= ~TRAP_BIT(i);
+            }
+            if(s->seen[i] == CITY_UNKNOWN || s->seen[i] == SEA_UNKNOWN) {
+                s->seen[i] = to;
+            }
+        }
+    }
+    if(s->vampire != NO_VAMPIRE && s->trail[s->vampire] == to) {
+        s->vampire = NO_VAMPIRE;
+    }
+    if(to == s->location[PLAYER_DRACULA] && s->health[h] > 0 &&
+       s->health[PLAYER_DRACULA] > 0) {
+        s->health[h] -= LIFE_LOSS_DRACULA_ENCOUNTER;
+        s->health[PLAYER_DRACULA] -= LIFE_LOSS_HUNTER_ENCOUNTER;
+    }
+
+    if(s->health[h] <= 0) {
+        s->health[h] = 0;
+        s->score -= SCORE_LOSS_HUNTER_HOSPITAL;
+        to = ST_JOSEPH_AND_ST_MARYS;
+    } else if(to == s->location[h]) {
+        s->health[h] += LIFE_GAIN_REST;
+        if(s->health[h] > GAME_START_HUNTER_LIFE_POINTS) {
+            s->health[h] = GAME_START_HUNTER_LIFE_POINTS;
+        }
+    }
+    s->location[h] = to;
+}
+
+// The part of the key a move by mover can change: whose turn it is, the
+// mover's place and health, the next player's health (from hospital),
+// Dracula's blood, the encounters, and his trail if it's his move
+static uint64_t moverKey(const GameState *s, PlayerID mover)
+{
+    PlayerID next = nextPlayer(mover);
+    uint64_t key = keyOf(KEY_PLAYER, 0, s->player) ^
+                   keyOf(KEY_LOCATION, mover, s->location[mover]) ^
+                   keyOf(KEY_HEALTH, mover, s->health[mover]) ^
+                   keyOf(KEY_HEALTH, next, s->health[next]) ^
+                   keyOf(KEY_TRAPS, 0, s->traps) ^
+                   keyOf(KEY_VAMPIRE, 0, s->vampire);
+    if(mover == PLAYER_DRACULA) {
+        int i;
+        for(i = 0; i < TRAIL_SIZE; i++) {
+            key ^= keyOf(KEY_TRAIL, i, s->trail[i]) ^
+                   keyOf(KEY_MOVE, i, s->moves[i]);
+        }
+    } else if(next != PLAYER_DRACULA) {
+        key ^= keyOf(KEY_HEALTH, PLAYER_DRACULA, s->health[PLAYER_DRACULA]);
+    }
+    return key;
+}
+
+// A random looking key for one thing having one value, worked out rather
+// than looked up, so there's no table to fill in first (it's splitmix64's
+// finaliser on the three packed together)
+static uint64_t keyOf(int kind, int index, int value)
+{
+    uint64_t z = ((uint64_t)kind << 40) | ((uint64_t)index << 32) |
+                 (uint32_t)value;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Who plays after p
+static PlayerID nextPlayer(PlayerID p)
+{
+    return (p == PLAYER_DRACULA) ? PLAYER_LORD_GODALMING : p + 1;
+}
+
+// Where a double back takes Dracula
+static LocationID doubleBackTo(const GameState *s, LocationID move)
+{
+    return s->trail[move - DOUBLE_BACK_FIRST];
+}
+
+// How many encounters Dracula has left at a place
+static int encountersAt(const GameState *s, LocationID where)
+{
+    int n = trapsAt(s, where);
+    if(vampireLocation(s) == where) {
+        n++;
+    }
+    return n;
+}
+
+// How the hunters see a place Dracula's been to until it's revealed
+static LocationID unknownPlace(LocationID where)
+{
+    return (idToType(where) == SEA) ? SEA_UNKNOWN : CITY_UNKNOWN;
+}
@@ -0,0 +1,127 @@
+// GameState.h ... the whole game in a few dozen bytes, for searching
+// A GameView is built from the plays, and building another one for every
+// position a search looks at would cost far more than the search itself.
+// A GameState is plain data, so it's copied with = and moves are played
+// on it in place, without any allocation, and taken back just as cheaply
+// Dracula's encounters belong to the moves that left them, so they live
+// alongside his trail and leave it with them
+// Each state carries a Zobrist key, kept up to date move by move, so
+// positions reached by different orders of moves can be recognised
+
+#ifndef GAME_STATE_H
+#define GAME_STATE_H
+
+#include <stdint.h>
+#include "Globals.h"
+#include "Places.h"
+
+// Dracula leaves a vampire rather than a trap in rounds divisible by this
+#define VAMPIRE_ROUNDS 13
+
+// the most encounters a city can hold
+#define MAX_ENCOUNTERS 3
+
+// most moves anyone can have in one turn (Dracula, on his first)
+#define MAX_STATE_MOVES NUM_MAP_LOCATIONS
+
+// vampire when there's no immature vampire about
+#define NO_VAMPIRE -1
+
+typedef struct gameState {
+    uint64_t key;                     // the position's Zobrist key: the
+                                      //   whole of it but the round,
+                                      //   the score and seen
+    short health[NUM_PLAYERS];        // life points, and Dracula's blood
+    short score;
+    short round;
+    signed char player;               // whose turn it is
+    signed char location[NUM_PLAYERS];// where each player is
+    signed char trail[TRAIL_SIZE];    // where Dracula has been, most
+                                      //   recent first (NOWHERE before
+                                      //   his first move)
+    signed char moves[TRAIL_SIZE];    // and the moves that took him there
+    signed char seen[TRAIL_SIZE];     // those moves as the hunters see
+                                      //   them: a place once it's been
+                                      //   revealed, CITY_UNKNOWN or
+                                      //   SEA_UNKNOWN until then
+    unsigned char traps;              // which moves left a trap that's
+                                      //   still there (bit i: trail[i])
+    signed char vampire;              // which move left the immature
+                                      //   vampire, or NO_VAMPIRE
+} GameState;
+
+// Everything a move can change that can't be worked out again, kept by
+// makeMove() for undoMove()
+typedef struct gameUndo {
+    uint64_t key;
+    short health;                     // the mover's, before
+    short nextHealth;                 // the next player's
+    short draculaHealth;
+    short score;
+    signed char location;             // the mover's, before
+    signed char trail;                // what fell off Dracula's trail
+    signed char move;
+    signed char seen[TRAIL_SIZE];
+    unsigned char traps;
+    signed char vampire;
+} GameUndo;
+
+// draculaMoves() puts every move Dracula can make into moves[] (places,
+//   HIDE, DOUBLE_BACK_N, or TELEPORT if there's nothing else), and where
+//   each one takes him into dests[]; returns how many there are
+// Both arrays must have room for MAX_STATE_MOVES
+// (see DracMoves.h for checking a move without listing them all)
+
+int draculaMoves(const GameState *s, LocationID moves[], LocationID dests[]);
+
+// hunterMoves() gives every place the given hunter can move to on their
+//   next turn, their own place included, and sets numMoves
+// The hunter must already be on the map
+// The array belongs to the map and must not be freed or changed
+
+const LocationID *hunterMoves(const GameState *s, PlayerID hunter,
+                              int *numMoves);
+
+// applyMove() plays move for whoever's turn it is: a place for a hunter,
+//   one of draculaMoves() for Dracula
+// Follows the same rules as GameView: blood lost at sea and gained at the
+//   castle; Dracula leaving a trap in each city he moves to (a vampire
+//   instead, every VAMPIRE_ROUNDS rounds), unless it already has
+//   MAX_ENCOUNTERS; traps expiring and vampires maturing as they leave
+//   the trail; hunters running into traps, the vampire and Dracula, in
+//   that order; resting, and going to hospital
+// Dracula's move is revealed if he's at the castle or moves onto a
+//   hunter, and any of his trail a hunter steps onto is revealed
+
+void applyMove(GameState *s, LocationID move);
+
+// makeMove() plays move just as applyMove() does, keeping in undo what's
+//   needed to take it back
+
+void makeMove(GameState *s, LocationID move, GameUndo *undo);
+
+// undoMove() takes back the last move made on s, with what makeMove()
+//   kept for it in undo
+// Moves must be taken back in the reverse of the order they were made
+
+void undoMove(GameState *s, const GameUndo *undo);
+
+// trapsAt() gives how many of Dracula's traps are at where
+
+int trapsAt(const GameState *s, LocationID where);
+
+// vampireLocation() gives where the immature vampire is, or NOWHERE
+
+LocationID vampireLocation(const GameState *s);
+
+// stateKey() works out s's Zobrist key from scratch
+// applyMove() keeps the key up to date by itself; anything else that
+//   changes a state should set its key with this afterwards
+
+uint64_t stateKey(const GameState *s);
+
+// isGameOver() is TRUE once Dracula is out of blood or the score is gone
+
+int isGameOver(const GameState *s);
+
+#endif
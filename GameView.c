@@ -26,9 +26,6 @@
 // id of the first round
 #define FIRST_ROUND 0
 
-// index that the location abbreviation starts in within the char *pastPlays
-#define LOC_ABBREV_INDEX 1
-
 // min and max values to double back
 #define MIN_DOUBLE_BACK 1
 #define MAX_DOUBLE_BACK 5
@@ -36,9 +33,6 @@
 // first value for doubling back (location id)
 #define FIRST_DOUBLE_BACK DOUBLE_BACK_1
 
-// arbitrarily 'big enough' value for infinity = 10^7
-#define INFINITY 10000000
-
 // mod that restricts the rail travel of the hunters by the sum of the round
 // and the hunter
 #define RAIL_RESTRICT 4    
@@ -49,12 +43,11 @@
 // ... plus a bit extra because josh is ultra-conservative
 #define MAX_PLAYS (366*5+5+10)
 
-// maximum length of past plays string
-#define MAX_PAST_PLAYS_LENGTH (MAX_PLAYS * CHARS_PER_PLAY_BLOCK)
+// the most rounds anyone can have played in
+#define MAX_ROUNDS ((MAX_PLAYS + NUM_PLAYERS - 1) / NUM_PLAYERS)
 
-// maximum length of any message
-// ... plus a bit extra because josh is ultra-conservative
-#define MAX_MESSAGE_LENGTH (MESSAGE_SIZE+10) 
+// bytes of store needed to hold n plays and their messages
+#define STORE_SIZE(n) ((n) * (CHARS_PER_PLAY_BLOCK + sizeof(PlayerMessage)))
 
 typedef struct _player {
     int health;
@@ -65,38 +58,118 @@ struct gameView {
     player players[NUM_PLAYERS];
 
     // dracula's trail; most recent last
+    // these are locations (as best we know them), not moves
     LocationID trail[TRAIL_SIZE];
-    char *messages[MAX_PLAYS];
-    char *pastPlays;
+
+    // number of traps we know of at each location
+    int numTraps[NUM_MAP_LOCATIONS];
+
+    // location of the vampire; at most 1 at any time
+    LocationID vampLoc;
+
+    // every play so far, decoded; history[player][round]
+    PlayRecord history[NUM_PLAYERS][MAX_ROUNDS];
+
     int score;
     int turns;
+
+    // the plays and their messages: either borrowed from the caller, or
+    // kept in store, one block holding room for capacity plays (the text
+    // first, then the messages)
+    char *pastPlays;
+    PlayerMessage *messages;
+    char *store;
+    int capacity;
+
+    // whether store is a separate malloc (otherwise it's on the end of this
+    // struct, or NULL if we're borrowing)
+    int ownsStore;
 };
      
 // --- Helper functions --- //
 
-// given 2 character string, work out what location id it matches to (not
-// necessarily a known place)
-static LocationID getNewLocation(char *abbrev);
+// the MOVE_ flags for the move tables, given the road and sea parameters
+static int moveFlags(int road, int sea);
 
-// given 2 ints, returns the smaller one
-static int min(int a, int b);
+// how many rail hops the given player gets in the given round
+static int railHops(PlayerID player, Round round, int rail);
 
 // Handles the adding/deleting of things on the trail
 // Also, updates Dracula's location 
 static void pushOnTrail (GameView g, LocationID placeID);
 
+// Updates the game state to account for a single play
+static void processPlay(GameView g, const char *play);
+
+// Takes a trap away from a location, if we knew it was there
+static void removeTrap(GameView g, LocationID where);
+
+// Does the actual work for newGameView() and newGameViewBorrowed()
+static GameView makeGameView(char *pastPlays, PlayerMessage messages[],
+                             int borrow);
+
+// Makes sure there is room in our own store for one more play
+static void makeRoom(GameView g);
+
+// Heals the current hunter if they were incapacitated last turn
+static void healCurrentHunter(GameView g);
+
+// Dracula's move in round r, as the hunters got to see it
+static LocationID seenMove(GameView g, Round r);
+
 // Creates a new GameView to summarise the current state of the game
 GameView newGameView(char *pastPlays, PlayerMessage messages[])
+{
+    return makeGameView(pastPlays, messages, FALSE);
+}
+
+// Creates a new GameView that reads pastPlays and messages in place
+GameView newGameViewBorrowed(char *pastPlays, PlayerMessage messages[])
+{
+    return makeGameView(pastPlays, messages, TRUE);
+}
+
+static GameView makeGameView(char *pastPlays, PlayerMessage messages[],
+                             int borrow)
 {
     assert(pastPlays != NULL);
     assert(messages != NULL);
 
-    GameView g = malloc(sizeof(struct gameView));
+    // every play but the last is followed by a separator
+    int numPlays = (strlen(pastPlays) + 1) / CHARS_PER_PLAY_BLOCK;
+    assert(numPlays <= MAX_PLAYS);
+
+    // leave a round's worth of room for appendPlay()
+    int capacity = 0;
+    if(borrow == FALSE) {
+        capacity = numPlays + NUM_PLAYERS;
+    }
+
+    // just the one malloc, with our copy of everything on the end
+    GameView g = malloc(sizeof(struct gameView) + STORE_SIZE(capacity));
 
     assert(g != NULL);
 
-    g->pastPlays = malloc(sizeof(char) * MAX_PAST_PLAYS_LENGTH);
-    int indexAt = 0;
+    if(borrow == TRUE) {
+        g->store = NULL;
+        g->pastPlays = pastPlays;
+        g->messages = messages;
+    } else {
+        g->store = (char *)(g + 1);
+        g->pastPlays = g->store;
+        g->messages =
+            (PlayerMessage *)(g->store + capacity * CHARS_PER_PLAY_BLOCK);
+
+        // make a copy of past plays and the messages
+        memcpy(g->pastPlays, pastPlays, numPlays * CHARS_PER_PLAY_BLOCK);
+        g->pastPlays[numPlays * CHARS_PER_PLAY_BLOCK] = '\0';
+        if(numPlays > 0) {
+            g->pastPlays[numPlays * CHARS_PER_PLAY_BLOCK - 1] = '\0';
+        }
+        memcpy(g->messages, messages, numPlays * sizeof(PlayerMessage));
+    }
+    g->capacity = capacity;
+    g->ownsStore = FALSE;
 
     // Initialise the hunters
     int i;
@@ -118,242 +191,19 @@ GameView newGameView(char *pastPlays, PlayerMessage messages[])
         g->trail[i] = NOWHERE;
     }
 
-    // make a copy of past plays
-    strncpy(g->pastPlays, pastPlays, MAX_PAST_PLAYS_LENGTH);
-    
-    // process the plays
-    while(pastPlays[indexAt] != '\0') {
-//        D("Play to process here is ");
-//        int x;
-//        for(x = 0; x < CHARS_PER_PLAY; x++) {
-//            D("%c",pastPlays[indexAt+x]);
-//        }
-//        D("\n");
-        
-        // copy message
-        // current turn index [0-based] is g->turns
-        // first, allocate space for the string
-        g->messages[g->turns] = 
-            (char *)(malloc(sizeof(char)*MAX_MESSAGE_LENGTH));
-
-        assert(g->messages[g->turns] != NULL);
-        assert(messages[g->turns] != NULL);
-
-        // copy string, using strncpy for safety
-        strncpy(g->messages[g->turns], messages[g->turns], MAX_MESSAGE_LENGTH);
-
-        // get the abbreviation for the new location
-        char abbrev[3];
-        abbrev[0] = pastPlays[indexAt+1];
-        abbrev[1] = pastPlays[indexAt+2];
-
-        // add a NUL terminator for good measure
-        abbrev[2] = '\0';
-
-        // try to get the place id of the current place
-        LocationID placeID = abbrevToID(abbrev);
-
-        // work out if dracula or a hunter
-        if(pastPlays[indexAt] == 'D') {
-            // This player is dracula
-            // We update his position.
-            
-            int isAtSea;
-            int isAtCastle;
-            if(placeID != NOWHERE) {
-                if(idToType(placeID) == SEA) {
-                    isAtSea = TRUE;
-                } else {
-                    isAtSea = FALSE;
-                }
-                if(placeID == CASTLE_DRACULA) {
-                    isAtCastle = TRUE;
-                } else {
-                    isAtCastle = FALSE;
-                }
-                pushOnTrail(g, placeID);
-            } else {
-                // This is not dracula's string and we do not know where he is
-                // And cannot update his position, other than saying if he is
-                // on land or at sea.
-                // We still need to know if he is at sea
-                if(abbrev[0] == 'C') {
-                    // He is in some city
-                    // That is not castle dracula
-                    isAtSea = FALSE;
-                    isAtCastle = FALSE;
-                    pushOnTrail(g, CITY_UNKNOWN);
-                    placeID = CITY_UNKNOWN;
-                } else if(abbrev[0] == 'S') {
-                    // He is at sea
-                    isAtSea = TRUE;
-                    isAtCastle = FALSE;
-                    pushOnTrail(g, SEA_UNKNOWN);
-                    placeID = SEA_UNKNOWN;
-                } else if(abbrev[0] == 'T') {
-                    // He is at the castle
-                    isAtSea = FALSE;
-                    isAtCastle = TRUE;
-                    pushOnTrail(g, CASTLE_DRACULA);
-
-                    // set placeID to be teleport
-                    placeID = TELEPORT;
-               } else if(abbrev[0] == 'D') {
-                    // He doubled back.
-                    // Because of the game's rules, we don't be clever and
-                    // instead place only the DOUBLE_BACK_ move type onto the
-                    // trail, even though we can (and do) infer the at-sea-ness
-                    // and location of dracula
-                    int numBack = (int)(abbrev[1]-'0');
-                    LocationID newPosition = g->trail[TRAIL_SIZE-numBack];
-
-//                    D("trail:");
-//                    for(i=0;i<TRAIL_SIZE;i++) {
-//                        D(" %d",g->trail[i]);
-//                    }
-//                    D("\n");
-//                    D("newPosition is %d\n",newPosition);
-
-                    if(newPosition == CITY_UNKNOWN) {
-                        isAtSea = FALSE;
-                        isAtCastle = FALSE;
-                    } else if (newPosition == SEA_UNKNOWN) {
-                        isAtSea = TRUE;
-                        isAtCastle = FALSE;
-                    } else {
-                        // We know exactly where dracula is
-                        if (idToType(newPosition) == SEA) {
-                            isAtSea = TRUE;
-                            isAtCastle = FALSE;
-                        } else if(newPosition == CASTLE_DRACULA) {
-                            isAtSea = FALSE;
-                            isAtCastle = TRUE;
-                        } else {
-                            isAtSea = FALSE;
-                            isAtCastle = FALSE;
-                        }
-                    }
-                    pushOnTrail(g, newPosition);
-
-                    // for sake of the getLocation function, we'll set
-                    // Dracula's new location to be the TYPE of move as opposed
-                    // to the city he's actually at even though we know what
-                    // that is
-                    placeID = (FIRST_DOUBLE_BACK-MIN_DOUBLE_BACK) + numBack;
-                } else if(abbrev[0] == 'H') {
-                    // He's HIDING!
-
-                    // push on the most recent location
-                    pushOnTrail(g, g->trail[TRAIL_SIZE-1]);
-
-                    // for sake of getLocation, make current location HIDE
-                    placeID = HIDE;
-                }
-            }
-
-            // set Dracula's 'public' location (as returned by getLocation)
-            g->players[PLAYER_DRACULA].position = placeID;
-
-            // Now we figure out what exactly dracula does at the new location
-            if(isAtSea) {
-                g->players[PLAYER_DRACULA].health -= LIFE_LOSS_SEA;
-            } else if(isAtCastle) {
-                g->players[PLAYER_DRACULA].health += LIFE_GAIN_CASTLE_DRACULA;
-            }
-
-            if(pastPlays[indexAt+3] == 'T') {
-                // Dracula placed a trap.
-                // TODO: Processing on what to do with traps
-                // So far, it doesn't seem like we need to do anything
-                // Since any encounters of traps are given to us
-                // so we don't need to know where these things are
-            }
-            if(pastPlays[indexAt+4] == 'V') {
-                // Dracula placed a young vampire
-                // TODO: See the section on traps just above
-            }
-
-            // What just left the trail?
-            if(pastPlays[indexAt+5] == 'V') {
-                // A vampire has matured
-                g->score -= SCORE_LOSS_VAMPIRE_MATURES;
-            }
-        } else {
-            // This player is one of the hunters
-            PlayerID curHunter;
-            switch (pastPlays[indexAt]) {
-                case 'G': curHunter = PLAYER_LORD_GODALMING; break;
-                case 'S': curHunter = PLAYER_DR_SEWARD; break;
-                case 'H': curHunter = PLAYER_VAN_HELSING; break;
-                case 'M': curHunter = PLAYER_MINA_HARKER; break;
-                default:
-                    assert (FALSE && "This is not a valid identifier for a player.");
-            }
-
-            LocationID newPosition = abbrevToID(abbrev);
-
-            if(g->players[curHunter].position == ST_JOSEPH_AND_ST_MARYS &&
-               g->players[curHunter].health == 0) {
-                // Our hunter has grown his legs back now.
-                g->players[curHunter].health = GAME_START_HUNTER_LIFE_POINTS;
-            }
-
-            // Check if some encounters were made
-            int i;
-
-            // only loop while our hunter is alive and kicking
-            // (and dracula, of course)
-            for(i = 3;i < CHARS_PER_PLAY && 
-                      g->players[curHunter].health > 0 &&
-                      g->players[PLAYER_DRACULA].health > 0; i++) {
-                if(pastPlays[indexAt+i] == 'T') {
-                    // Encountered a trap
-                    g->players[curHunter].health -= LIFE_LOSS_TRAP_ENCOUNTER;
-                } else if(pastPlays[indexAt+i] == 'D') {
-                    //D("ENCOUNTERED DRACULA\n");
-                    // Encountered Dracula
-                    g->players[curHunter].health -= LIFE_LOSS_DRACULA_ENCOUNTER;
-                    g->players[PLAYER_DRACULA].health -= LIFE_LOSS_HUNTER_ENCOUNTER;
-                }
-            }
-
-            // check if our hunter died =(
-            if (g->players[curHunter].health <= 0) {
-                g->players[curHunter].health = 0;
-                g->score -= SCORE_LOSS_HUNTER_HOSPITAL;
-                newPosition = ST_JOSEPH_AND_ST_MARYS;
-            } else if(newPosition == g->players[curHunter].position) {
-                // The hunter rests and regains some health
-                // Hunters need a bit of RnR, too!
-                g->players[curHunter].health += LIFE_GAIN_REST;
-
-                // cap hunter's health at GAME_START_HUNTER_LIFE_POINTS
-                if (g->players[curHunter].health > GAME_START_HUNTER_LIFE_POINTS) {
-                    g->players[curHunter].health = GAME_START_HUNTER_LIFE_POINTS;
-                }
-            }
+    // and the minions
+    for(i = 0; i < NUM_MAP_LOCATIONS; i++) {
+        g->numTraps[i] = 0;
+    }
+    g->vampLoc = NOWHERE;
 
-            // update our hunter's position
-            g->players[curHunter].position = newPosition;
-        }
+    // process the plays, once, working out everything as we go
+    for(i = 0; i < numPlays; i++) {
+        processPlay(g, g->pastPlays + i * CHARS_PER_PLAY_BLOCK);
         g->turns++;
-
-        // we increment this way just in case we overshoot the NUL terminator
-        // at the end of the string
-        indexAt += CHARS_PER_PLAY;
-        if(pastPlays[indexAt] == PLAY_SEP_CHAR) {
-            indexAt++;
-        }
     }
 
-    // A little special case to heal the current hunter if they've been 
-    // incapacitated last turn.
-    int turnPlayer = getCurrentPlayer(g);
-    if(g->players[turnPlayer].position == ST_JOSEPH_AND_ST_MARYS &&
-       g->players[turnPlayer].health == 0) {
-        // The hunter has regrown his legs!
-        g->players[turnPlayer].health = GAME_START_HUNTER_LIFE_POINTS;
-    }
+    healCurrentHunter(g);
 
     // print out messages for teh luls
 //    for(i=0;i<g->turns;i++) {
@@ -362,18 +212,43 @@ GameView newGameView(char *pastPlays, PlayerMessage messages[])
     return g;
 }
      
+// Adds one more play to the end of an existing GameView
+void appendPlay(GameView currentView, const char *play, PlayerMessage message)
+{
+    assert(currentView != NULL);
+    assert(play != NULL);
+    assert(message != NULL);
+    assert(currentView->turns < MAX_PLAYS);
+
+    makeRoom(currentView);
+
+    // tack it onto our copy of past plays
+    char *end = currentView->pastPlays +
+                (currentView->turns * CHARS_PER_PLAY_BLOCK);
+    if(currentView->turns > 0) {
+        end[-1] = PLAY_SEP_CHAR;
+    }
+    strncpy(end, play, CHARS_PER_PLAY);
+    end[CHARS_PER_PLAY] = '\0';
+
+    // message may be any string, so copy no further than its end
+    char *copy = currentView->messages[currentView->turns];
+    strncpy(copy, message, MESSAGE_SIZE - 1);
+    copy[MESSAGE_SIZE - 1] = '\0';
+    processPlay(currentView, end);
+    currentView->turns++;
+
+    healCurrentHunter(currentView);
+}
+     
 // Frees all memory previously allocated for the GameView toBeDeleted
 void disposeGameView(GameView toBeDeleted)
 {
     assert(toBeDeleted != NULL);
 
-    // free pastPlays
-    free(toBeDeleted->pastPlays);
-
-    // free messages
-    int i;
-    for(i=0;i<toBeDeleted->turns;i++) {
-        free(toBeDeleted->messages[i]);
+    // free our copy of past plays and messages, if it's separate
+    if(toBeDeleted->ownsStore == TRUE) {
+        free(toBeDeleted->store);
     }
 
     // free struct
@@ -426,6 +301,102 @@ LocationID getLocation(GameView currentView, PlayerID player)
     return currentView->players[player].position;
 }
 
+// Get the message that came with a past play
+const char *getMessage(GameView currentView, int turn)
+{
+    assert(currentView != NULL);
+    assert(0 <= turn && turn < currentView->turns);
+    return currentView->messages[turn];
+}
+
+// Get where Dracula has been over his last TRAIL_SIZE turns
+void getTrailLocations(GameView currentView, LocationID trail[TRAIL_SIZE])
+{
+    assert(currentView != NULL);
+    assert(trail != NULL);
+
+    // ours is most recent last; hand it out most recent first
+    int i;
+    for(i = 0; i < TRAIL_SIZE; i++) {
+        trail[i] = currentView->trail[TRAIL_SIZE-1-i];
+    }
+}
+
+// Get the number of traps known to be at a location
+int getTrapsAt(GameView currentView, LocationID where)
+{
+    assert(currentView != NULL);
+    assert(validPlace(where));
+    return currentView->numTraps[where];
+}
+
+// Get where the immature vampire is
+LocationID getVampireLocation(GameView currentView)
+{
+    assert(currentView != NULL);
+    return currentView->vampLoc;
+}
+
+// The game as it stands, as a GameState
+void getGameState(GameView currentView, GameState *state)
+{
+    assert(currentView != NULL);
+    assert(state != NULL);
+
+    int i;
+    for(i = 0; i < NUM_PLAYERS; i++) {
+        state->health[i] = currentView->players[i].health;
+        state->location[i] = currentView->players[i].position;
+    }
+    state->score = currentView->score;
+    state->round = getRound(currentView);
+    state->player = getCurrentPlayer(currentView);
+
+    // Dracula moves last, so his last move was in the round before this
+    state->traps = 0;
+    state->vampire = NO_VAMPIRE;
+    for(i = 0; i < TRAIL_SIZE; i++) {
+        Round r = getRound(currentView) - 1 - i;
+        state->trail[i] = currentView->trail[TRAIL_SIZE-1-i];
+        state->moves[i] = NOWHERE;
+        state->seen[i] = NOWHERE;
+        if(r >= FIRST_ROUND) {
+            const PlayRecord *record = &currentView->history[PLAYER_DRACULA][r];
+            state->moves[i] = record->move;
+            state->seen[i] = seenMove(currentView, r);
+
+            if(record->encounters & ENCOUNTER_PLACED_TRAP) {
+                state->traps |= 1 << i;
+            }
+            if((record->encounters & ENCOUNTER_PLACED_VAMPIRE) &&
+               currentView->vampLoc != NOWHERE &&
+               state->vampire == NO_VAMPIRE) {
+                state->vampire = i;
+            }
+        }
+    }
+    state->location[PLAYER_DRACULA] = state->trail[0];
+
+    // hunters take away the traps they find, which we only count by place;
+    // where we know the place, keep as many as there are, the newest
+    for(i = 0; i < TRAIL_SIZE; i++) {
+        LocationID where = state->trail[i];
+        if((state->traps & (1 << i)) && validPlace(where)) {
+            int newer = 0;
+            int j;
+            for(j = 0; j < i; j++) {
+                if((state->traps & (1 << j)) && state->trail[j] == where) {
+                    newer++;
+                }
+            }
+            if(newer >= currentView->numTraps[where]) {
+                state->traps &= ~(1 << i);
+            }
+        }
+    }
+    state->key = stateKey(state);
+}
+
 //// Functions that return information about the history of the game
 
 // Fills the trail array with the location ids of the last 6 turns
@@ -454,25 +425,46 @@ void getHistory(GameView currentView, PlayerID player,
         Round curRound = (Round)(lastRoundPlayed-i);
 
         if(curRound >= FIRST_ROUND) {
-            // number of the turn (NOT type Round since it's a turn not a round)
-            int turnNo = (curRound * NUM_PLAYERS) + player;
-
-            // pointer to the start of the play; some pointer arithmetic
-            char *startOfPlay = (currentView->pastPlays) + 
-                                (turnNo * CHARS_PER_PLAY_BLOCK);
+            // already worked out when we read the play
+            trail[i] = currentView->history[player][curRound].move;
 
-            // get id from the abbreviation (located in the first two characters of
-            // start of play and store it in the trail
-            trail[i] = (LocationID)(getNewLocation(startOfPlay +
-                                                   LOC_ABBREV_INDEX));
+            // we've always given a teleport as the castle itself
+            if(trail[i] == TELEPORT) {
+                trail[i] = CASTLE_DRACULA;
+            }
         } else {
             // no previous location
             trail[i] = UNKNOWN_LOCATION;
         }
-//        D("trail for player %d: %d rounds ago: %d [round %d]\n",player, i, trail[i], curRound);
     }
 }
 
+// Gives a window of the given player's decoded plays
+const PlayRecord *getFullHistory(GameView currentView, PlayerID player,
+                                 Round from, Round to, int *numRecords)
+{
+    assert(currentView != NULL);
+    assert(0 <= player && player < NUM_PLAYERS);
+    assert(FIRST_ROUND <= from && from <= to);
+    assert(numRecords != NULL);
+
+    // the number of rounds this player has played in
+    Round played = getRound(currentView);
+    if(getCurrentPlayer(currentView) > player) {
+        played++;
+    }
+
+    if(to > played) {
+        to = played;
+    }
+    if(from > to) {
+        from = to;
+    }
+
+    (*numRecords) = to - from;
+    return currentView->history[player] + from;
+}
+
 //// Functions that query the map to find information about connectivity
 
 // Returns an array of LocationIDs for all directly connected locations
@@ -480,180 +472,299 @@ void getHistory(GameView currentView, PlayerID player,
 LocationID *connectedLocations(GameView currentView, int *numLocations,
         LocationID from, PlayerID player, Round round,
         int road, int rail, int sea)
+{
+    const LocationID *canReach =
+        connectedLocationsList(currentView, numLocations, from, player,
+                               round, road, rail, sea);
+
+    // our return array; big enough to conserve memory
+    LocationID *ret = 
+        (LocationID *)(malloc((*numLocations) * sizeof(LocationID)));
+
+    memcpy(ret, canReach, (*numLocations) * sizeof(LocationID));
+
+    return ret;
+}
+
+// Returns the precomputed list of all directly connected locations
+
+const LocationID *connectedLocationsList(GameView currentView,
+        int *numLocations, LocationID from, PlayerID player, Round round,
+        int road, int rail, int sea)
 {
     assert(currentView != NULL);
     assert(numLocations != NULL);
     assert(validPlace(from));
     assert(0 <= player && player < NUM_PLAYERS);
-    
-    int i, j, k;
 
-    // our map
-    Map ourMap = newMap();
+    int flags = moveFlags(road, sea);
+    const LocationID *ret;
 
-    // boolean array storing whether or not we can reach each vertex
-    int canReach[NUM_MAP_LOCATIONS];
-
-    // initialise it
-    for(i=0;i<NUM_MAP_LOCATIONS;i++) {
-        canReach[i] = FALSE;
-    }
-    
-    // remember we can always reach ourselves
-    canReach[from] = TRUE;
-
-    // pairwise shortest rail distances
-    int railDist[NUM_MAP_LOCATIONS][NUM_MAP_LOCATIONS];
-
-    // floyd warshall to calculate pariwse shortest paths.
-
-    // initialise distances
-    for(i=0;i<NUM_MAP_LOCATIONS;i++) {
-        for(j=0;j<NUM_MAP_LOCATIONS;j++) {
-            if(i == j) {
-                railDist[i][j] = 0;
-            } else {
-                int edgeDist = getDist(ourMap, RAIL, i, j);
-                if(edgeDist == NO_EDGE) {
-                    edgeDist = INFINITY;
-                }
-                railDist[i][j] = edgeDist;
-            }
-        }
+    if(player == PLAYER_DRACULA) {
+        ret = draculaMoveList(getMap(), from, flags, numLocations);
+    } else {
+        ret = hunterMoveList(getMap(), from, railHops(player, round, rail),
+                             flags, numLocations);
     }
 
-    // floyd warshall time!
-    for(j=0;j<NUM_MAP_LOCATIONS;j++) {
-        for(i=0;i<NUM_MAP_LOCATIONS;i++) {
-            for(k=0;k<NUM_MAP_LOCATIONS;k++) {
-                railDist[i][k] = min(railDist[i][k], railDist[i][j] + railDist[j][k]);
-            }
-        }
+    return ret;
+}
+
+// Returns the set of all directly connected locations
+
+LocationSet connectedLocationsSet(GameView currentView,
+        LocationID from, PlayerID player, Round round,
+        int road, int rail, int sea)
+{
+    assert(currentView != NULL);
+    assert(validPlace(from));
+    assert(0 <= player && player < NUM_PLAYERS);
+
+    int flags = moveFlags(road, sea);
+    LocationSet ret;
+
+    if(player == PLAYER_DRACULA) {
+        ret = draculaMoveSet(getMap(), from, flags);
+    } else {
+        ret = hunterMoveSet(getMap(), from, railHops(player, round, rail),
+                            flags);
     }
 
-    // actually do the thing
-    
-    // invoke special rules: transform road, rail and sea not just to store
-    // TRUE/FALSE but to store the maximum number of edges of that type we can
-    // move in
+    return ret;
+}
 
-    if(rail == TRUE) {
-        if(player == PLAYER_DRACULA) {
-            // dracula can't move by rail
-            rail = 0;
+static int moveFlags(int road, int sea) {
+    // MOVE_ROAD | MOVE_SEA, without any branches
+    return ((road == TRUE) * MOVE_ROAD) | ((sea == TRUE) * MOVE_SEA);
+}
+
+static int railHops(PlayerID player, Round round, int rail) {
+    // how far a hunter can move by rail depends on the round and the
+    // hunter (and dracula never gets to take the train)
+    return ((round+player) % RAIL_RESTRICT) *
+           (rail == TRUE && player != PLAYER_DRACULA);
+}
+
+// Updates the game state to account for a single play
+static void processPlay(GameView g, const char *play)
+{
+    // decode the play straight into its record, then fill in the rest
+    PlayRecord *record = &g->history[getCurrentPlayer(g)][getRound(g)];
+    decodePlay(play, record);
+
+    // the move as written: a place, or one of Dracula's special moves
+    LocationID move = record->move;
+
+    // work out if dracula or a hunter
+    if(record->player == PLAYER_DRACULA) {
+        // This player is dracula
+        // We update his position.
+
+        // what's about to fall off the end of his trail
+        LocationID leaving = g->trail[0];
+
+        // where he really is now, as far as we can tell
+        LocationID here;
+        if(move == TELEPORT) {
+            // He is at the castle
+            here = CASTLE_DRACULA;
+        } else if(move == HIDE) {
+            // He's HIDING! at the most recent location
+            here = g->trail[TRAIL_SIZE-1];
+        } else if(FIRST_DOUBLE_BACK <= move &&
+                  move < FIRST_DOUBLE_BACK + MAX_DOUBLE_BACK) {
+            // He doubled back.
+            // Because of the game's rules, getLocation() still gives the
+            // DOUBLE_BACK_ move type, even though we can (and do) infer the
+            // at-sea-ness and location of dracula
+            int numBack = (move - FIRST_DOUBLE_BACK) + MIN_DOUBLE_BACK;
+            here = g->trail[TRAIL_SIZE-numBack];
         } else {
-            // determine how far hunters can move by rail
-            rail = (round+player) % RAIL_RESTRICT;
+            // a real place, or CITY_UNKNOWN / SEA_UNKNOWN if this is not
+            // dracula's string and we do not know where he is
+            here = move;
         }
-    } else {
-        rail = 0;
-    }
 
-//    D("rail=%d\n",rail);
+        // he can't hide at sea, but he can stay in the castle
+        int isAtSea = (here == SEA_UNKNOWN ||
+                       (validPlace(here) && idToType(here) == SEA));
+        int isAtCastle = (here == CASTLE_DRACULA);
 
-    // add rail links
-    for(i=0;i<NUM_MAP_LOCATIONS;i++) {
-        if(railDist[from][i] <= rail) {
-            canReach[i] = TRUE;
+        if(move != NOWHERE) {
+            pushOnTrail(g, here);
         }
-    }
+        record->location = here;
 
-    if(road == TRUE) {
-        road = 1;
-    } else {
-        road = 0;
-    }
+        // set Dracula's 'public' location (as returned by getLocation)
+        g->players[PLAYER_DRACULA].position = move;
 
-    // add road links
-    for(i=0;i<NUM_MAP_LOCATIONS;i++) {
-        int distHere = getDist(ourMap, ROAD, from, i);
-        if(distHere != NO_EDGE && distHere <= road) {
-            canReach[i] = TRUE;
+        // every turn he takes costs the hunters a point
+        g->score -= SCORE_LOSS_DRACULA_TURN;
+
+        // Now we figure out what exactly dracula does at the new location
+        if(isAtSea) {
+            g->players[PLAYER_DRACULA].health -= LIFE_LOSS_SEA;
+        } else if(isAtCastle) {
+            g->players[PLAYER_DRACULA].health += LIFE_GAIN_CASTLE_DRACULA;
         }
-    }
 
-    if(sea == TRUE) {
-        sea = 1;
+        if(record->encounters & ENCOUNTER_PLACED_TRAP) {
+            // Dracula placed a trap.
+            if(validPlace(here)) {
+                g->numTraps[here]++;
+            }
+        }
+        if(record->encounters & ENCOUNTER_PLACED_VAMPIRE) {
+            // Dracula placed a young vampire (maybe somewhere we can't see)
+            g->vampLoc = here;
+        }
+
+        // What just left the trail?
+        if(record->encounters & ENCOUNTER_TRAP_EXPIRED) {
+            // A trap has malfunctioned
+            removeTrap(g, leaving);
+        } else if(record->encounters & ENCOUNTER_VAMPIRE_MATURED) {
+            // A vampire has matured
+            g->score -= SCORE_LOSS_VAMPIRE_MATURES;
+            g->vampLoc = NOWHERE;
+        }
     } else {
-        sea = 0;
-    }
+        // This player is one of the hunters
+        PlayerID curHunter = record->player;
+        LocationID newPosition = move;
+
+        if(g->players[curHunter].position == ST_JOSEPH_AND_ST_MARYS &&
+           g->players[curHunter].health == 0) {
+            // Our hunter has grown his legs back now.
+            g->players[curHunter].health = GAME_START_HUNTER_LIFE_POINTS;
+        }
+
+        // Check if some encounters were made
+        int numTraps = record->encounters & ENCOUNTER_TRAPS_MASK;
+        int i;
+
+        // anything they found along the way is gone now
+        for(i = 0; i < numTraps; i++) {
+            // fell into a trap but disarmed it
+            removeTrap(g, newPosition);
+        }
+        if(record->encounters & ENCOUNTER_VAMPIRE) {
+            // vanquished a vampire
+            g->vampLoc = NOWHERE;
+        }
+
+        // plays list traps, then the vampire, then Dracula; only carry on
+        // while our hunter is alive and kicking (and dracula, of course)
+        for(i = 0; i < numTraps && g->players[curHunter].health > 0; i++) {
+            // Encountered a trap
+            g->players[curHunter].health -= LIFE_LOSS_TRAP_ENCOUNTER;
+        }
+        if((record->encounters & ENCOUNTER_DRACULA) &&
+           g->players[curHunter].health > 0 &&
+           g->players[PLAYER_DRACULA].health > 0) {
+            // Encountered Dracula
+            g->players[curHunter].health -= LIFE_LOSS_DRACULA_ENCOUNTER;
+            g->players[PLAYER_DRACULA].health -= LIFE_LOSS_HUNTER_ENCOUNTER;
+        }
 
-    // add sea links
-    for(i=0;i<NUM_MAP_LOCATIONS;i++) {
-        int distHere = getDist(ourMap, BOAT, from, i);
-        if(distHere != NO_EDGE && distHere <= sea) {
-            canReach[i] = TRUE;
+        // check if our hunter died =(
+        if (g->players[curHunter].health <= 0) {
+            g->players[curHunter].health = 0;
+            g->score -= SCORE_LOSS_HUNTER_HOSPITAL;
+            newPosition = ST_JOSEPH_AND_ST_MARYS;
+            record->encounters |= ENCOUNTER_HOSPITAL;
+        } else if(newPosition == g->players[curHunter].position) {
+            // The hunter rests and regains some health
+            // Hunters need a bit of RnR, too!
+            g->players[curHunter].health += LIFE_GAIN_REST;
+
+            // cap hunter's health at GAME_START_HUNTER_LIFE_POINTS
+            if (g->players[curHunter].health > GAME_START_HUNTER_LIFE_POINTS) {
+                g->players[curHunter].health = GAME_START_HUNTER_LIFE_POINTS;
+            }
         }
+
+        // update our hunter's position
+        g->players[curHunter].position = newPosition;
     }
+}
 
-    // ensure Dracula can't move to the hospital
-    if(player == PLAYER_DRACULA) {
-        canReach[ST_JOSEPH_AND_ST_MARYS] = FALSE;
+// Takes a trap away from a location, if we knew it was there
+static void removeTrap(GameView g, LocationID where)
+{
+    if(validPlace(where) && g->numTraps[where] > 0) {
+        g->numTraps[where]--;
     }
+}
 
-    // output
+// Makes sure there is room in our own store for one more play, moving
+// everything into a bigger block (or out of the caller's arrays) if not
+static void makeRoom(GameView g)
+{
+    if(g->turns >= g->capacity) {
+        int capacity = 2 * g->capacity;
+        if(capacity < g->turns + NUM_PLAYERS) {
+            capacity = g->turns + NUM_PLAYERS;
+        }
 
-    // work out numLocations; initialise it to be 0
-    (*numLocations) = 0;
+        char *store = malloc(STORE_SIZE(capacity));
+        assert(store != NULL);
 
-    // count number of locations
-    for(i=0;i<NUM_MAP_LOCATIONS;i++) {
-        if(canReach[i] == TRUE) {
-            (*numLocations)++;
-        }
-    }
+        PlayerMessage *messages =
+            (PlayerMessage *)(store + capacity * CHARS_PER_PLAY_BLOCK);
 
-    // our return array; big enough to conserve memory
-    LocationID *ret = 
-        (LocationID *)(malloc((*numLocations) * sizeof(LocationID)));
+        memcpy(store, g->pastPlays, g->turns * CHARS_PER_PLAY_BLOCK);
+        memcpy(messages, g->messages, g->turns * sizeof(PlayerMessage));
 
-    // current index we're up to
-    int upto = 0;
-    for(i=0;i<NUM_MAP_LOCATIONS;i++) {
-        if(canReach[i] == TRUE) {
-            ret[upto] = i;
-            upto++;
+        if(g->ownsStore == TRUE) {
+            free(g->store);
         }
+        g->store = store;
+        g->pastPlays = store;
+        g->messages = messages;
+        g->capacity = capacity;
+        g->ownsStore = TRUE;
     }
-
-    return ret;
 }
 
-static LocationID getNewLocation(char *abbrev) {
-    assert(abbrev != NULL);
-
-    // return value
-    LocationID ret;
-
-    if(abbrev[0] == 'C' && abbrev[1] == '?') {
-        ret = CITY_UNKNOWN;
-    } else if(abbrev[0] == 'S' && abbrev[1] == '?') {
-        ret = SEA_UNKNOWN;
-    } else if(abbrev[0] == 'H' && abbrev[1] == 'I') {
-        ret = HIDE;
-    } else if(abbrev[0] == 'D' &&
-              '0'+MIN_DOUBLE_BACK <= abbrev[1] &&
-              abbrev[1] <= '0'+MAX_DOUBLE_BACK) {
-        ret = (FIRST_DOUBLE_BACK - MIN_DOUBLE_BACK) + (abbrev[1] - '0');
-    } else if(abbrev[0] == 'T' && abbrev[1] == 'P') {
-        ret = (LocationID)(CASTLE_DRACULA);
-    } else {
-        // doesn't match any, try converting to place name
-        ret = abbrevToID(abbrev);
+// A little special case to heal the current hunter if they've been 
+// incapacitated last turn.
+static void healCurrentHunter(GameView g)
+{
+    int turnPlayer = getCurrentPlayer(g);
+    if(g->players[turnPlayer].position == ST_JOSEPH_AND_ST_MARYS &&
+       g->players[turnPlayer].health == 0) {
+        // The hunter has regrown his legs!
+        g->players[turnPlayer].health = GAME_START_HUNTER_LIFE_POINTS;
     }
-
-    return ret;
 }
 
-static int min(int a, int b) {
-    // abiding by the style guide: no multiple returns
-    int ret;
-    if(a < b) {
-        ret = a;
-    } else {
-        ret = b;
+// A place is revealed if it's the castle, or a hunter was there when he
+// arrived or has been since
+static LocationID seenMove(GameView g, Round r)
+{
+    const PlayRecord *record = &g->history[PLAYER_DRACULA][r];
+    LocationID seen = record->move;
+    if(validPlace(seen) && seen != CASTLE_DRACULA) {
+        int revealed = FALSE;
+        PlayerID h;
+        for(h = 0; h < PLAYER_DRACULA && !revealed; h++) {
+            // the hunters move before him in a round, so start from r
+            int numRecords;
+            const PlayRecord *moves =
+                getFullHistory(g, h, r, MAX_ROUNDS, &numRecords);
+            int i;
+            for(i = 0; i < numRecords && !revealed; i++) {
+                if(moves[i].location == seen) {
+                    revealed = TRUE;
+                }
+            }
+        }
+        if(!revealed) {
+            seen = (idToType(seen) == SEA) ? SEA_UNKNOWN : CITY_UNKNOWN;
+        }
     }
-    return ret;
+    return seen;
 }
 
 static void pushOnTrail (GameView g, LocationID placeID) {
@@ -8,6 +8,9 @@
 #include "Globals.h"
 #include "Game.h"
 #include "Places.h"
+#include "LocationSet.h"
+#include "PlayDecoder.h"
+#include "GameState.h"
 
 typedef struct gameView *GameView;
 
@@ -27,6 +30,25 @@ typedef struct gameView *GameView;
 
 GameView newGameView(char *pastPlays, PlayerMessage messages[]);
 
+// newGameViewBorrowed() is the same as newGameView(), except that the view
+// reads pastPlays and messages where they are instead of copying them, so
+// building it costs a single malloc. The caller must keep both arrays alive
+// and unchanged until the view is disposed of (appendPlay() is still fine;
+// the view takes its own copy the first time it needs to add to them).
+// newGameView() itself copies everything into the same single malloc.
+
+GameView newGameViewBorrowed(char *pastPlays, PlayerMessage messages[]);
+
+
+// appendPlay() brings an existing game view up to date with one more play,
+// exactly as if newGameView() had been given pastPlays with that play on the
+// end. play is the 7 characters of the play (anything after them is
+// ignored) and message is the message that came with it.
+// It only looks at the new play, so a long-lived view (or a search) can
+// follow the game along without reparsing everything from round 0.
+
+void appendPlay(GameView currentView, const char *play, PlayerMessage message);
+
 
 // disposeGameView() frees all memory previously allocated for the GameView
 // toBeDeleted. toBeDeleted should not be accessed after the call.
@@ -84,6 +106,44 @@ int getHealth(GameView currentView, PlayerID player);
 LocationID getLocation(GameView currentView, PlayerID player);
 
 
+// Get the message that came with a past play
+// 'turn' counts plays from 0 (the first play of the game) and must be less
+//    than the number of plays so far
+// The string belongs to the view; it is only looked at when asked for
+
+const char *getMessage(GameView currentView, int turn);
+
+// Fills the trail array with where Dracula actually was on each of his last
+//   6 turns, most recent first: unlike getHistory(), HIDE, DOUBLE_BACK_N and
+//   TELEPORT are followed to the location they lead to
+// Each entry is:
+//   in the interval [0...70] if the plays pin down where he was
+//   CITY_UNKNOWN     if he was in an unknown city
+//   SEA_UNKNOWN      if he was in an unknown sea
+//   UNKNOWN_LOCATION if he hadn't had that many turns yet
+// (so with Dracula's full pastPlays, every entry is a real location)
+
+void getTrailLocations(GameView currentView, LocationID trail[TRAIL_SIZE]);
+
+// Get the number of traps known to be at the given location
+// Only counts traps that were placed somewhere the plays reveal
+
+int getTrapsAt(GameView currentView, LocationID where);
+
+// Get the location of Dracula's immature vampire
+// Returns NOWHERE if there isn't one, or CITY_UNKNOWN if there is one but
+//   the plays don't say where
+
+LocationID getVampireLocation(GameView currentView);
+
+// getGameState() fills state with the game as it stands, for a search
+//   to play moves on (see GameState.h)
+// Dracula's location and trail are as getTrailLocations() gives them, so
+//   they're only all real places if the plays are Dracula's
+
+void getGameState(GameView currentView, GameState *state);
+
+
 //// Functions that return information about the history of the game
 
 // Fills the trail array with the location ids of the last 6 turns
@@ -109,6 +169,16 @@ LocationID getLocation(GameView currentView, PlayerID player);
 void getHistory(GameView currentView, PlayerID player,
                  LocationID trail[TRAIL_SIZE]);
 
+// getFullHistory() gives the given player's plays in rounds [from...to),
+//   oldest first, with no limit on how far back it goes
+// Rounds the player hasn't played yet are left out, so the number of
+//   records is stored in the variable pointed to by numRecords
+// The records belong to the view: nothing is allocated or copied, and
+//   they stay valid until the view is disposed of
+
+const PlayRecord *getFullHistory(GameView currentView, PlayerID player,
+                                 Round from, Round to, int *numRecords);
+
 
 //// Functions that query the map to find information about connectivity
 
@@ -127,4 +197,20 @@ LocationID *connectedLocations(GameView currentView, int *numLocations,
                                LocationID from, PlayerID player, Round round,
                                int road, int rail, int sea);
 
+// connectedLocationsSet() is connectedLocations() returning a LocationSet
+//   instead of a malloc'd array; nothing is allocated
+
+LocationSet connectedLocationsSet(GameView currentView,
+                                  LocationID from, PlayerID player, Round round,
+                                  int road, int rail, int sea);
+
+// connectedLocationsList() is connectedLocations() without the malloc:
+//   the array returned is a precomputed table (in id order) that must not
+//   be freed or changed
+
+const LocationID *connectedLocationsList(GameView currentView,
+                                         int *numLocations, LocationID from,
+                                         PlayerID player, Round round,
+                                         int road, int rail, int sea);
+
 #endif
@@ -0,0 +1,567 @@
+// HunterMcts.c ... HunterMcts ADT implementation
+// Single observer ISMCTS: the tree alternates between the searching
+// hunter's decisions (children are their moves) and what they see after
+// the round (children are observations). Everyone else moves as in the
+// playouts, and within a world every move is known, so a round is played
+// straight through
+// With more than one thread, each grows a tree of its own over the same
+// worlds, in batches, and the roots are added up between batches to
+// choose the move to offer (as in DracMcts.c)
+// At the root only moves worth considering are tried: the searching
+// hunter's undominated moves (see HunterMoves.h), given where Dracula is
+// or has been in any of the worlds (sifting the hunters' joint moves
+// instead takes milliseconds and throws out next to nothing). Further
+// down, what's worth considering would depend on the world, and choosing
+// by that would let the search see through to where Dracula really is
+// The caller can narrow the root down further, to keep to a plan
+// There's no transposition table: a node stands for what the searching
+// hunter has seen, not for a position, and judging moves by the worlds'
+// positions would see through to Dracula just the same
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include "Globals.h"
+#include "Game.h"
+#include "Places.h"
+#include "LocationSet.h"
+#include "GameState.h"
+#include "TrailEnum.h"
+#include "Anytime.h"
+#include "Random.h"
+#include "Playout.h"
+#include "Workers.h"
+#include "HunterMoves.h"
+#include "HunterMcts.h"
+
+#define MSECS_PER_SEC 1000.0
+
+#define ROOT 0
+#define NO_NODE -1
+
+// how far down the tree a playout can go, in nodes (two a round)
+#define MAX_PATH 128
+
+// how many rounds a playout goes on for once it leaves the tree
+#define ROLLOUT_ROUNDS 10
+
+// UCT's exploration constant, for rewards in [0, 1]
+#define EXPLORATION 0.7
+
+// how often, in playouts, to look at the clock, and how many playouts
+// each thread runs between offers of the best move
+#define PLAYOUTS_PER_CHECK 256
+#define PLAYOUTS_PER_OFFER 4096
+
+// no limit on how many playouts a thread runs
+#define NO_LIMIT -1
+
+typedef struct node {
+    // how many playouts came through here, and the hunter's total reward
+    int visits;
+    float value;
+
+    // for a move: how many times it could have been made when a playout
+    // came through its parent
+    int available;
+
+    // children in a list; key is the move, or what was seen of Dracula
+    int firstChild;
+    int nextSibling;
+    signed char key;
+} Node;
+
+// one thread's tree, and its own random numbers
+typedef struct tree {
+    Node *nodes;
+    int maxNodes;
+    int numNodes;
+
+    RandomState rng;
+
+    long long playouts;
+
+    // how many playouts this thread has left, and how many of them to run
+    // in this batch
+    long long left;
+    int batch;
+} Tree;
+
+struct hunterMcts {
+    Tree *trees;
+    int numTrees;
+    Workers workers;
+
+    uint64_t seed;
+
+    // each world as a whole position, so a playout just copies one
+    GameState *worlds;
+    int numWorlds;
+
+    // the moves tried from the root, out of how many there are, and the
+    // ones the caller wants kept to
+    LocationSet rootMoves;
+    LocationSet focus;
+    int numLegal;
+
+    // the clock for the search in progress, for the threads
+    Anytime clock;
+};
+
+static LocationSet rootMoves(HunterMcts m, const GameState *root);
+static void runBatch(int worker, void *data);
+static void playout(HunterMcts m, Tree *t, GameState s);
+static int addChild(Tree *t, int parent, LocationID key);
+static int findChild(Tree *t, int parent, LocationID key);
+static int selectMove(Tree *t, int n, LocationSet legal);
+static LocationID randomMember(Tree *t, LocationSet set);
+static void playRound(GameState *s, LocationID move, RandomState *rng);
+static LocationID observe(const GameState *s);
+static LocationID mostTried(HunterMcts m, int *visits);
+static void report(HunterMcts m, Anytime clock, PlayerMessage message);
+
+// Makes a search on numThreads threads, with room for maxNodes nodes
+HunterMcts newHunterMcts(int maxNodes, int numThreads, uint64_t seed)
+{
+    assert(numThreads > 0);
+    assert(maxNodes / numThreads > 0);
+
+    HunterMcts m = malloc(sizeof(struct hunterMcts));
+    assert(m != NULL);
+    m->workers = newWorkers(numThreads);
+    m->numTrees = numWorkers(m->workers);
+    m->trees = malloc(m->numTrees * sizeof(Tree));
+    assert(m->trees != NULL);
+
+    int i;
+    for(i = 0; i < m->numTrees; i++) {
+        Tree *t = &m->trees[i];
+        t->maxNodes = maxNodes / m->numTrees;
+        t->nodes = malloc(t->maxNodes * sizeof(Node));
+        assert(t->nodes != NULL);
+        t->numNodes = 0;
+        t->playouts = 0;
+    }
+    m->seed = seed;
+    m->worlds = NULL;
+    m->numWorlds = 0;
+    m->rootMoves = setEmpty();
+    m->focus = setEmpty();
+    m->numLegal = 0;
+    m->clock = NULL;
+
+    return m;
+}
+
+// Frees all memory allocated for toBeDeleted
+void disposeHunterMcts(HunterMcts toBeDeleted)
+{
+    assert(toBeDeleted != NULL);
+    disposeWorkers(toBeDeleted->workers);
+    int i;
+    for(i = 0; i < toBeDeleted->numTrees; i++) {
+        free(toBeDeleted->trees[i].nodes);
+    }
+    free(toBeDeleted->trees);
+    free(toBeDeleted->worlds);
+    free(toBeDeleted);
+}
+
+// Searches from root, over the worlds, until the time's up
+LocationID searchHunterMcts(HunterMcts m, const GameState *root,
+                            const TrailHypothesis worlds[], int numWorlds,
+                            Anytime clock, long long maxPlayouts)
+{
+    assert(m != NULL);
+    assert(root != NULL && root->player != PLAYER_DRACULA);
+    assert(worlds != NULL && numWorlds > 0);
+    assert(clock != NULL);
+
+    // fill in Dracula's trail for each world, once
+    free(m->worlds);
+    m->worlds = malloc(numWorlds * sizeof(GameState));
+    assert(m->worlds != NULL);
+    m->numWorlds = numWorlds;
+    int i, j;
+    for(i = 0; i < numWorlds; i++) {
+        m->worlds[i] = *root;
+        for(j = 0; j < TRAIL_SIZE; j++) {
+            m->worlds[i].trail[j] = worlds[i].loc[j];
+        }
+        m->worlds[i].location[PLAYER_DRACULA] = worlds[i].loc[0];
+        m->worlds[i].key = stateKey(&m->worlds[i]);
+    }
+
+    m->rootMoves = rootMoves(m, root);
+    m->clock = clock;
+
+    // each thread's random numbers start from the next of the seed's own,
+    // so they're well apart; the playouts are shared out as evenly as
+    // they go
+    RandomState seeds;
+    seedRandom(&seeds, m->seed);
+    for(i = 0; i < m->numTrees; i++) {
+        Tree *t = &m->trees[i];
+        seedRandom(&t->rng, nextRandom(&seeds));
+        t->playouts = 0;
+        t->left = NO_LIMIT;
+        if(maxPlayouts > 0) {
+            t->left = maxPlayouts / m->numTrees +
+                      (i < maxPlayouts % m->numTrees);
+        }
+        t->numNodes = 0;
+        addChild(t, NO_NODE, NOWHERE);
+    }
+
+    LocationID move = NOWHERE;
+    int more = TRUE;
+    while(more) {
+        more = FALSE;
+        for(i = 0; i < m->numTrees; i++) {
+            Tree *t = &m->trees[i];
+            t->batch = PLAYOUTS_PER_OFFER;
+            if(t->left != NO_LIMIT && t->left < t->batch) {
+                t->batch = t->left;
+            }
+            if(t->batch > 0) {
+                more = TRUE;
+            }
+        }
+
+        if(more) {
+            runWorkers(m->workers, runBatch, m);
+
+            int visits;
+            move = mostTried(m, &visits);
+            if(move != NOWHERE) {
+                PlayerMessage message;
+                report(m, clock, message);
+                offerMove(clock, move, 1, visits, message);
+            }
+            more = !timeIsUp(clock);
+        }
+    }
+
+    PlayerMessage message;
+    report(m, clock, message);
+    restateMove(clock, message);
+
+    m->clock = NULL;
+    return move;
+}
+
+// Keeps the root to moves
+void focusHunterMcts(HunterMcts m, LocationSet moves)
+{
+    assert(m != NULL);
+    m->focus = moves;
+}
+
+// How many playouts the last search ran
+long long hunterMctsPlayouts(HunterMcts m)
+{
+    assert(m != NULL);
+    long long playouts = 0;
+    int i;
+    for(i = 0; i < m->numTrees; i++) {
+        playouts += m->trees[i].playouts;
+    }
+    return playouts;
+}
+
+// How big the last search's trees were
+int hunterMctsTreeSize(HunterMcts m)
+{
+    assert(m != NULL);
+    int size = 0;
+    int i;
+    for(i = 0; i < m->numTrees; i++) {
+        size += m->trees[i].numNodes;
+    }
+    return size;
+}
+
+// How many threads the search runs on
+int hunterMctsThreads(HunterMcts m)
+{
+    assert(m != NULL);
+    return m->numTrees;
+}
+
+// The moves worth trying from root, given the worlds
+static LocationSet rootMoves(HunterMcts m, const GameState *root)
+{
+    PlayerID me = root->player;
+    hunterMoves(root, me, &m->numLegal);
+
+    // landing anywhere he might be or have been finds something out
+    LocationSet dracula = setEmpty();
+    LocationSet encounters = setEmpty();
+    int i, j;
+    for(i = 0; i < m->numWorlds; i++) {
+        for(j = 0; j < TRAIL_SIZE; j++) {
+            if(validPlace(m->worlds[i].trail[j])) {
+                setAdd(&dracula, m->worlds[i].trail[j]);
+            }
+        }
+    }
+    for(j = 0; j < TRAIL_SIZE; j++) {
+        LocationID where = root->trail[j];
+        if(validPlace(where) && trapsAt(root, where) > 0) {
+            setAdd(&encounters, where);
+        }
+    }
+    LocationID vampire = vampireLocation(root);
+    if(validPlace(vampire)) {
+        setAdd(&encounters, vampire);
+    }
+
+    LocationSet worthIt = hunterOptions(root, me, dracula, encounters);
+
+    LocationSet focused = setIntersect(worthIt, m->focus);
+    if(!setIsEmpty(focused)) {
+        worthIt = focused;
+    }
+    return worthIt;
+}
+
+// One thread's share of a batch: its playouts, unless the time's up
+// Between them the threads take the worlds in turn
+static void runBatch(int worker, void *data)
+{
+    HunterMcts m = data;
+    Tree *t = &m->trees[worker];
+
+    int i = 0;
+    while(i < t->batch) {
+        long long turn = t->playouts * m->numTrees + worker;
+        playout(m, t, m->worlds[turn % m->numWorlds]);
+        t->playouts++;
+        i++;
+        if(i % PLAYOUTS_PER_CHECK == 0 && timeIsUp(m->clock)) {
+            t->batch = i;
+        }
+    }
+    if(t->left != NO_LIMIT) {
+        t->left -= i;
+    }
+}
+
+// One playout in the world s: down the tree, on at random, and back up
+static void playout(HunterMcts m, Tree *t, GameState s)
+{
+    PlayerID me = s.player;
+    int path[MAX_PATH];
+    int depth = 0;
+
+    int n = ROOT;
+    path[depth++] = n;
+    int descending = TRUE;
+    while(descending && !isGameOver(&s) && depth + 2 <= MAX_PATH) {
+        // the moves we could make in this world
+        int numMoves;
+        const LocationID *moves = hunterMoves(&s, me, &numMoves);
+        LocationSet legal = setFromArray(moves, numMoves);
+        if(n == ROOT) {
+            legal = setIntersect(legal, m->rootMoves);
+        }
+
+        // every one of them that's in the tree was available; any that
+        // aren't haven't been tried
+        LocationSet untried = legal;
+        int c;
+        for(c = t->nodes[n].firstChild; c != NO_NODE;
+            c = t->nodes[c].nextSibling) {
+            if(setHas(legal, t->nodes[c].key)) {
+                t->nodes[c].available++;
+                setRemove(&untried, t->nodes[c].key);
+            }
+        }
+
+        LocationID move;
+        int moveNode;
+        if(setIsEmpty(untried)) {
+            moveNode = selectMove(t, n, legal);
+            move = t->nodes[moveNode].key;
+        } else {
+            // try something new, then play out from there
+            move = randomMember(t, untried);
+            moveNode = addChild(t, n, move);
+            descending = FALSE;
+        }
+
+        playRound(&s, move, &t->rng);
+
+        if(moveNode != NO_NODE) {
+            path[depth++] = moveNode;
+
+            // what we saw decides where we are in the tree
+            if(descending) {
+                LocationID seen = observe(&s);
+                n = findChild(t, moveNode, seen);
+                if(n == NO_NODE) {
+                    n = addChild(t, moveNode, seen);
+                    descending = FALSE;
+                }
+                if(n != NO_NODE) {
+                    path[depth++] = n;
+                }
+            }
+        } else {
+            descending = FALSE;
+        }
+    }
+
+    playOut(&s, &t->rng, ROLLOUT_ROUNDS);
+    double r = 1 - draculaReward(&s);
+
+    int i;
+    for(i = 0; i < depth; i++) {
+        t->nodes[path[i]].visits++;
+        t->nodes[path[i]].value += r;
+    }
+}
+
+// Adds a child with the given key to parent, if there's room; returns it,
+// or NO_NODE if there wasn't
+static int addChild(Tree *t, int parent, LocationID key)
+{
+    int n = NO_NODE;
+    if(t->numNodes < t->maxNodes) {
+        n = t->numNodes++;
+        Node *node = &t->nodes[n];
+        node->visits = 0;
+        node->value = 0;
+        node->available = 1;
+        node->firstChild = NO_NODE;
+        node->key = key;
+
+        node->nextSibling = NO_NODE;
+        if(parent != NO_NODE) {
+            node->nextSibling = t->nodes[parent].firstChild;
+            t->nodes[parent].firstChild = n;
+        }
+    }
+    return n;
+}
+
+// The child of parent with the given key, or NO_NODE
+static int findChild(Tree *t, int parent, LocationID key)
+{
+    int c = t->nodes[parent].firstChild;
+    while(c != NO_NODE && t->nodes[c].key != key) {
+        c = t->nodes[c].nextSibling;
+    }
+    return c;
+}
+
+// UCT over the moves that are legal in this world, each judged by how
+// often it was available rather than by its parent's visits
+static int selectMove(Tree *t, int n, LocationSet legal)
+{
+    int best = NO_NODE;
+    double bestBound = 0;
+    int c;
+    for(c = t->nodes[n].firstChild; c != NO_NODE;
+        c = t->nodes[c].nextSibling) {
+        const Node *child = &t->nodes[c];
+        if(setHas(legal, child->key)) {
+            double bound = child->value / child->visits +
+                           EXPLORATION *
+                           sqrt(log(child->available) / child->visits);
+            if(best == NO_NODE || bound > bestBound) {
+                best = c;
+                bestBound = bound;
+            }
+        }
+    }
+    return best;
+}
+
+// Any member of a (non-empty) set, each as likely
+static LocationID randomMember(Tree *t, LocationSet set)
+{
+    int skip = randomBelow(&t->rng, setSize(set));
+    LocationID v = setNext(set, 0);
+    while(skip > 0) {
+        v = setNext(set, v+1);
+        skip--;
+    }
+    return v;
+}
+
+// Makes our move, then everyone else's until it's our turn again
+static void playRound(GameState *s, LocationID move, RandomState *rng)
+{
+    PlayerID me = s->player;
+    applyMove(s, move);
+    while(!isGameOver(s) && s->player != me) {
+        applyMove(s, playoutMove(s, rng));
+    }
+}
+
+// What the hunters get to see of Dracula after a round: where he is if
+// a hunter has run into him or he's at the castle, otherwise only
+// whether he's on land or at sea
+static LocationID observe(const GameState *s)
+{
+    LocationID dracula = s->location[PLAYER_DRACULA];
+
+    int seen = (dracula == CASTLE_DRACULA);
+    PlayerID h;
+    for(h = 0; h < PLAYER_DRACULA && !seen; h++) {
+        if(s->location[h] == dracula) {
+            seen = TRUE;
+        }
+    }
+
+    LocationID what = dracula;
+    if(!seen) {
+        what = (idToType(dracula) == SEA) ? SEA_UNKNOWN : CITY_UNKNOWN;
+    }
+    return what;
+}
+
+// The move most tried from the root, counting every tree's tries, and
+// how many tries that was
+// The trees try their moves in different orders, so they're added up by
+// move rather than by node
+static LocationID mostTried(HunterMcts m, int *visits)
+{
+    int total[NUM_MAP_LOCATIONS] = {0};
+    int i, c;
+    for(i = 0; i < m->numTrees; i++) {
+        const Tree *t = &m->trees[i];
+        for(c = t->nodes[ROOT].firstChild; c != NO_NODE;
+            c = t->nodes[c].nextSibling) {
+            total[(int)t->nodes[c].key] += t->nodes[c].visits;
+        }
+    }
+
+    LocationID best = NOWHERE;
+    int bestVisits = 0;
+    LocationID v;
+    for(v = MIN_MAP_LOCATION; v <= MAX_MAP_LOCATION; v++) {
+        if(total[v] > bestVisits) {
+            best = v;
+            bestVisits = total[v];
+        }
+    }
+
+    (*visits) = bestVisits;
+    return best;
+}
+
+// How the search is going, as a message
+static void report(HunterMcts m, Anytime clock, PlayerMessage message)
+{
+    double secs = msecsUsed(clock) / MSECS_PER_SEC;
+    long long playouts = hunterMctsPlayouts(m);
+    snprintf(message, MESSAGE_SIZE,
+             "%lld playouts in %d worlds on %d threads, %.0f/sec, "
+             "%d of %d moves",
+             playouts, m->numWorlds, m->numTrees,
+             (secs > 0) ? playouts / secs : 0,
+             setSize(m->rootMoves), m->numLegal);
+}
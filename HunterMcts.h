@@ -0,0 +1,70 @@
+// HunterMcts.h ... information set Monte Carlo tree search for a hunter
+// The hunters don't know where Dracula is, so a search can't be run on
+// the one true position. Instead each playout is played in a world picked
+// from a pool of determinizations: trails Dracula could really have left,
+// given everything the hunters have seen. The tree is shared by all of
+// them. Its nodes are keyed by what the searching hunter knows: their own
+// moves, and what they get to see of Dracula after each round (where he
+// is, if a hunter runs into him or he's at the castle, or else just land
+// or sea). A move is only chosen among those that were possible in the
+// world being played, and it's judged by how often it was possible
+// It can run on several threads, each growing a tree of its own over the
+// same worlds, whose roots are added together to choose the move
+
+#ifndef HUNTER_MCTS_H
+#define HUNTER_MCTS_H
+
+#include <stdint.h>
+#include "Globals.h"
+#include "Places.h"
+#include "GameState.h"
+#include "LocationSet.h"
+#include "TrailEnum.h"
+#include "Anytime.h"
+
+typedef struct hunterMcts *HunterMcts;
+
+// newHunterMcts() makes a search on numThreads threads, with room for
+//   maxNodes tree nodes shared out between them
+// seed starts the random numbers, so the same worlds searched for the
+//   same number of playouts on the same number of threads always give
+//   the same move
+
+HunterMcts newHunterMcts(int maxNodes, int numThreads, uint64_t seed);
+
+// disposeHunterMcts() frees all memory allocated for toBeDeleted
+
+void disposeHunterMcts(HunterMcts toBeDeleted);
+
+// searchHunterMcts() searches from root for the hunter whose turn it is,
+//   until clock's time is up or maxPlayouts playouts have been run (0 for
+//   no limit), offering its best move to clock every so often
+// root is the game as the hunters see it; each of the numWorlds worlds
+//   (at least one) fills in Dracula's trail, and they're used in turn
+// Starts a new tree every time
+// Returns the best move: the one most often tried from root, or NOWHERE
+//   if nothing was (the game is already over)
+
+LocationID searchHunterMcts(HunterMcts m, const GameState *root,
+                            const TrailHypothesis worlds[], int numWorlds,
+                            Anytime clock, long long maxPlayouts);
+
+// focusHunterMcts() keeps the root of searches from now on to moves, as
+//   far as any of them are worth trying (setEmpty() for no focus)
+
+void focusHunterMcts(HunterMcts m, LocationSet moves);
+
+// hunterMctsPlayouts() gives how many playouts the last search ran
+
+long long hunterMctsPlayouts(HunterMcts m);
+
+// hunterMctsTreeSize() gives how many nodes the last search's trees had
+
+int hunterMctsTreeSize(HunterMcts m);
+
+// hunterMctsThreads() gives how many threads the search runs on (fewer
+//   than asked for if the system wouldn't start them all)
+
+int hunterMctsThreads(HunterMcts m);
+
+#endif
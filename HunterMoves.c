@@ -0,0 +1,232 @@
+// HunterMoves.c ... picking out the hunters' undominated moves
+// Each move is summed up as a reach, a coverage and some extras; one move
+// dominates another if it has all of the other's of each. For one hunter
+// every pair is checked. For joint moves that would be too many pairs,
+// so they're sorted so that anything that dominates a move comes before
+// it, and each is only checked against those already kept
+
+#include <stdlib.h>
+#include <assert.h>
+#include "Globals.h"
+#include "Places.h"
+#include "Map.h"
+#include "LocationSet.h"
+#include "GameState.h"
+#include "HunterMoves.h"
+
+// mod that restricts the rail travel of the hunters by the sum of the round
+// and the hunter
+#define RAIL_RESTRICT 4
+
+#define ALL_MOVES (MOVE_ROAD | MOVE_SEA)
+
+// one hunter's move, summed up
+typedef struct option {
+    LocationID move;
+    LocationSet reach;
+    LocationSet cover;
+    unsigned char extras;
+} Option;
+
+static int optionsFrom(LocationID from, int railHops, LocationSet dracula,
+                       LocationSet encounters, Option options[]);
+static int dominates(LocationSet reachA, LocationSet coverA, int extrasA,
+                     LocationSet reachB, LocationSet coverB, int extrasB);
+static int compareJoints(const void *a, const void *b);
+static int jointDominates(const JointMove *a, const JointMove *b);
+
+// The moves worth considering from from
+LocationSet undominatedMoves(LocationID from, int railHops,
+                             LocationSet dracula, LocationSet encounters)
+{
+    Option options[NUM_MAP_LOCATIONS];
+    int n = optionsFrom(from, railHops, dracula, encounters, options);
+
+    LocationSet moves = setEmpty();
+    int i;
+    for(i = 0; i < n; i++) {
+        setAdd(&moves, options[i].move);
+    }
+    return moves;
+}
+
+// The moves worth considering for hunter
+LocationSet hunterOptions(const GameState *s, PlayerID hunter,
+                          LocationSet dracula, LocationSet encounters)
+{
+    assert(s != NULL);
+    assert(0 <= hunter && hunter < PLAYER_DRACULA);
+
+    // if they've had their turn this round, it's next round's rail
+    Round round = s->round + (hunter < s->player);
+    return undominatedMoves(s->location[hunter],
+                            (round + hunter) % RAIL_RESTRICT,
+                            dracula, encounters);
+}
+
+// Every undominated joint move for the rest of the round
+int jointHunterMoves(const GameState *s, LocationSet dracula,
+                     LocationSet encounters, JointMove joints[],
+                     int maxJoints)
+{
+    assert(s != NULL);
+    assert(joints != NULL && maxJoints > 0);
+
+    // each hunter's undominated moves; those who've moved already stay
+    // where they are, which gets them nothing more this round
+    Option options[NUM_HUNTERS][NUM_MAP_LOCATIONS];
+    int numOptions[NUM_HUNTERS];
+    long long combinations = 1;
+    PlayerID h;
+    for(h = 0; h < NUM_HUNTERS; h++) {
+        Round round = s->round + (h < s->player);
+        int railHops = (round + h) % RAIL_RESTRICT;
+        if(h < s->player) {
+            Option *o = &options[h][0];
+            o->move = s->location[h];
+            o->reach = hunterMoveSet(getMap(), o->move, railHops, ALL_MOVES);
+            o->cover = setEmpty();
+            o->extras = 0;
+            numOptions[h] = 1;
+        } else {
+            numOptions[h] = optionsFrom(s->location[h], railHops, dracula,
+                                        encounters, options[h]);
+        }
+        combinations *= numOptions[h];
+    }
+
+    int n = combinations;
+    if(combinations <= maxJoints) {
+        // every combination, counting through them like an odometer
+        int which[NUM_HUNTERS] = {0};
+        int i;
+        for(i = 0; i < n; i++) {
+            JointMove *j = &joints[i];
+            j->reach = setEmpty();
+            j->cover = setEmpty();
+            j->extras = 0;
+            for(h = 0; h < NUM_HUNTERS; h++) {
+                const Option *o = &options[h][which[h]];
+                j->move[h] = o->move;
+                j->reach = setUnion(j->reach, o->reach);
+                j->cover = setUnion(j->cover, o->cover);
+                j->extras |= o->extras << (h * NUM_EXTRAS);
+            }
+
+            h = NUM_HUNTERS - 1;
+            which[h]++;
+            while(h > 0 && which[h] == numOptions[h]) {
+                which[h] = 0;
+                h--;
+                which[h]++;
+            }
+        }
+
+        // anything that dominates a joint move sorts before it, and
+        // dominance carries over, so checking against what's been kept
+        // is enough
+        qsort(joints, n, sizeof(JointMove), compareJoints);
+        int kept = 0;
+        for(i = 0; i < n; i++) {
+            int dominated = FALSE;
+            int k;
+            for(k = 0; k < kept && !dominated; k++) {
+                dominated = jointDominates(&joints[k], &joints[i]);
+            }
+            if(!dominated) {
+                joints[kept++] = joints[i];
+            }
+        }
+        n = kept;
+    }
+    return n;
+}
+
+// Sums up each move a hunter at from can make, keeping the undominated
+// ones in options; returns how many there are
+// A hunter who isn't on the map yet can start anywhere but the hospital
+static int optionsFrom(LocationID from, int railHops, LocationSet dracula,
+                       LocationSet encounters, Option options[])
+{
+    LocationSet moves;
+    if(from == NOWHERE) {
+        moves = setAll();
+        setRemove(&moves, ST_JOSEPH_AND_ST_MARYS);
+    } else {
+        moves = hunterMoveSet(getMap(), from, railHops, ALL_MOVES);
+    }
+
+    // where each move gets them to on the turn after
+    int nextHops = (railHops + 1) % RAIL_RESTRICT;
+    Option all[NUM_MAP_LOCATIONS];
+    int numAll = 0;
+    LocationID v;
+    for(v = setNext(moves, 0); v != NOWHERE; v = setNext(moves, v+1)) {
+        Option *o = &all[numAll++];
+        o->move = v;
+        o->reach = hunterMoveSet(getMap(), v, nextHops, ALL_MOVES);
+        o->cover = setIntersect(dracula, setOf(v));
+        o->extras = 0;
+        if(v == from) {
+            o->extras |= EXTRA_REST;
+        }
+        if(setHas(encounters, v)) {
+            o->extras |= EXTRA_ENCOUNTER;
+        }
+    }
+
+    // of equals, the first (lowest numbered) is kept
+    int n = 0;
+    int i, j;
+    for(i = 0; i < numAll; i++) {
+        const Option *a = &all[i];
+        int dominated = FALSE;
+        for(j = 0; j < numAll && !dominated; j++) {
+            const Option *b = &all[j];
+            if(j != i &&
+               dominates(b->reach, b->cover, b->extras,
+                         a->reach, a->cover, a->extras)) {
+                dominated = !dominates(a->reach, a->cover, a->extras,
+                                       b->reach, b->cover, b->extras) ||
+                            j < i;
+            }
+        }
+        if(!dominated) {
+            options[n++] = *a;
+        }
+    }
+    return n;
+}
+
+// Is A at least as good as B in every way?
+static int dominates(LocationSet reachA, LocationSet coverA, int extrasA,
+                     LocationSet reachB, LocationSet coverB, int extrasB)
+{
+    return setIsSubset(reachB, reachA) && setIsSubset(coverB, coverA) &&
+           (extrasB & ~extrasA) == 0;
+}
+
+// Joint moves in an order where a move comes after everything that
+// dominates it: most places first, then most extras, then by their moves
+static int compareJoints(const void *a, const void *b)
+{
+    const JointMove *x = a;
+    const JointMove *y = b;
+    int diff = (setSize(y->reach) + setSize(y->cover)) -
+               (setSize(x->reach) + setSize(x->cover));
+    if(diff == 0) {
+        diff = __builtin_popcount(y->extras) - __builtin_popcount(x->extras);
+    }
+    PlayerID h;
+    for(h = 0; h < NUM_HUNTERS && diff == 0; h++) {
+        diff = x->move[h] - y->move[h];
+    }
+    return diff;
+}
+
+// Is joint move a at least as good as b in every way?
+static int jointDominates(const JointMove *a, const JointMove *b)
+{
+    return dominates(a->reach, a->cover, a->extras,
+                     b->reach, b->cover, b->extras);
+}
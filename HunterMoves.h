@@ -0,0 +1,68 @@
+// HunterMoves.h ... the hunters' moves worth thinking about
+// A hunter with rail can have dozens of places to go, and the hunters
+// between them the product of that. Most of those moves are no better
+// than some other: they leave the hunter able to get to fewer places next
+// turn, they don't land on any place Dracula might be or have been, and
+// they don't rest or clear anything. Such a move is dominated, and is
+// dropped. What's left is worked out with set operations on each move's
+// next-turn reach, so it costs next to nothing
+// The same goes for the hunters together: a joint move, one move each,
+// is dominated if another one's reach and coverage between them take in
+// all of its own, and it rests or clears nothing the other doesn't
+
+#ifndef HUNTER_MOVES_H
+#define HUNTER_MOVES_H
+
+#include "Globals.h"
+#include "Places.h"
+#include "LocationSet.h"
+#include "GameState.h"
+
+#define NUM_HUNTERS (NUM_PLAYERS - 1)
+
+// what a move does besides getting somewhere, as bits (a joint move has
+// NUM_EXTRAS of them for each hunter, hunter 0's lowest)
+#define EXTRA_REST 1                  // stays put, and so recovers
+#define EXTRA_ENCOUNTER 2             // lands on a known trap or vampire
+#define NUM_EXTRAS 2
+
+// one move for each hunter, and what they add up to
+typedef struct jointMove {
+    signed char move[NUM_HUNTERS];
+    LocationSet reach;                // everywhere they can get to between
+                                      //   them on their turns after
+    LocationSet cover;                // the places in dracula they land on
+    unsigned char extras;
+} JointMove;
+
+// undominatedMoves() gives the moves worth considering for a hunter at
+//   from, allowed railHops rail hops this turn
+// dracula is where landing would find something out: everywhere Dracula
+//   might be, or have been in his trail; encounters are the places the
+//   hunters know hold traps or the vampire
+// Of moves that are as good as each other in every way, only the lowest
+//   numbered place is kept
+
+LocationSet undominatedMoves(LocationID from, int railHops,
+                             LocationSet dracula, LocationSet encounters);
+
+// hunterOptions() gives undominatedMoves() for the given hunter on their
+//   next turn from s
+
+LocationSet hunterOptions(const GameState *s, PlayerID hunter,
+                          LocationSet dracula, LocationSet encounters);
+
+// jointHunterMoves() puts into joints every undominated joint move for
+//   the hunters still to move this round from s (those who've moved
+//   already stay where they are), with dracula and encounters as for
+//   undominatedMoves(), and returns how many there are
+// They come most reaching first. Only moves that are undominated on
+//   their own are combined; if there are more than maxJoints combinations
+//   of those, nothing is put into joints and it returns how many
+//   combinations there are (more than maxJoints)
+
+int jointHunterMoves(const GameState *s, LocationSet dracula,
+                     LocationSet encounters, JointMove joints[],
+                     int maxJoints);
+
+#endif
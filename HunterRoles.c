@@ -0,0 +1,285 @@
+// HunterRoles.c ... HunterRoles implementation
+// The regions are a weighted k-median clustering on hops: centres are
+// added one at a time, each where it cuts the weighted hops from every
+// place to its nearest centre the most, then each place goes to its
+// nearest centre and each centre moves to the middle of its region, a
+// few times over. With at most four regions and four hunters, every way
+// of giving the hunters regions is tried, judged by the turns each hunter
+// needs to get to their region's centre; there are no more than 4^4
+// Ties always go to the lowest numbered place, region or hunter, so the
+// same weights and places always give the same roles
+
+#include <stdlib.h>
+#include <assert.h>
+#include "Globals.h"
+#include "Places.h"
+#include "LocationSet.h"
+#include "Playout.h"
+#include "HunterRoles.h"
+
+#define NUM_HUNTERS (NUM_PLAYERS - 1)
+
+// how many times to move the centres to the middle of their regions
+#define REFINE_PASSES 4
+
+// the places with some weight, and the hops to each of them from
+// everywhere, looked up once
+typedef struct targets {
+    int numPlaces;
+    LocationID place[NUM_MAP_LOCATIONS];
+    double weight[NUM_MAP_LOCATIONS];
+    unsigned char hops[NUM_MAP_LOCATIONS][NUM_MAP_LOCATIONS];
+} Targets;
+
+static void findTargets(const double weight[NUM_MAP_LOCATIONS], Targets *t);
+static int chooseCentres(const Targets *t, LocationID centres[]);
+static int splitPlaces(const Targets *t, const LocationID centres[],
+                       int numCentres, int regionOf[]);
+static LocationID middleOf(const Targets *t, const int regionOf[], int r);
+static void chooseRoles(const LocationID hunters[NUM_HUNTERS], Round round,
+                        Roles *roles);
+
+// Splits the weight into regions, and gives each hunter one
+void assignRoles(const double weight[NUM_MAP_LOCATIONS],
+                 const LocationID hunters[NUM_HUNTERS], Round round,
+                 Roles *roles)
+{
+    assert(weight != NULL && hunters != NULL && roles != NULL);
+
+    Targets t;
+    findTargets(weight, &t);
+    LocationID centres[MAX_REGIONS];
+    int numCentres = chooseCentres(&t, centres);
+
+    // each place to its nearest centre, and each centre to the middle of
+    // its region, until they settle
+    int regionOf[NUM_MAP_LOCATIONS];
+    int used = splitPlaces(&t, centres, numCentres, regionOf);
+    int moved = TRUE;
+    int pass, r;
+    for(pass = 0; pass < REFINE_PASSES && moved; pass++) {
+        moved = FALSE;
+        for(r = 0; r < numCentres; r++) {
+            if(used & (1 << r)) {
+                LocationID middle = middleOf(&t, regionOf, r);
+                if(middle != centres[r]) {
+                    centres[r] = middle;
+                    moved = TRUE;
+                }
+            }
+        }
+        if(moved) {
+            used = splitPlaces(&t, centres, numCentres, regionOf);
+        }
+    }
+
+    // keep the regions that have anything in them
+    int index[MAX_REGIONS];
+    roles->numRegions = 0;
+    for(r = 0; r < numCentres; r++) {
+        if(used & (1 << r)) {
+            int n = roles->numRegions++;
+            index[r] = n;
+            roles->region[n] = setEmpty();
+            roles->centre[n] = centres[r];
+            roles->weight[n] = 0;
+        }
+    }
+    int i;
+    for(i = 0; i < t.numPlaces; i++) {
+        int n = index[regionOf[i]];
+        setAdd(&roles->region[n], t.place[i]);
+        roles->weight[n] += t.weight[i];
+    }
+
+    chooseRoles(hunters, round, roles);
+}
+
+// The places with some weight, and how far they are from everywhere
+static void findTargets(const double weight[NUM_MAP_LOCATIONS], Targets *t)
+{
+    t->numPlaces = 0;
+    LocationID v;
+    for(v = MIN_MAP_LOCATION; v <= MAX_MAP_LOCATION; v++) {
+        if(weight[v] > 0) {
+            t->place[t->numPlaces] = v;
+            t->weight[t->numPlaces] = weight[v];
+            t->numPlaces++;
+        }
+    }
+
+    LocationID c;
+    int i;
+    for(c = MIN_MAP_LOCATION; c <= MAX_MAP_LOCATION; c++) {
+        for(i = 0; i < t->numPlaces; i++) {
+            t->hops[c][i] = hopsBetween(c, t->place[i]);
+        }
+    }
+}
+
+// Adds centres one at a time, each where it cuts the weighted hops from
+// places to their nearest centre the most, until there are MAX_REGIONS,
+// or one for each place, or another wouldn't help; returns how many
+static int chooseCentres(const Targets *t, LocationID centres[])
+{
+    // how far each place is from its nearest centre so far
+    int nearest[NUM_MAP_LOCATIONS];
+    int i;
+    for(i = 0; i < t->numPlaces; i++) {
+        nearest[i] = NUM_MAP_LOCATIONS;
+    }
+
+    int numCentres = 0;
+    double spread = 0;
+    int better = TRUE;
+    while(numCentres < MAX_REGIONS && numCentres < t->numPlaces && better) {
+        LocationID best = NOWHERE;
+        double bestSpread = 0;
+        LocationID c;
+        for(c = MIN_MAP_LOCATION; c <= MAX_MAP_LOCATION; c++) {
+            if(c != ST_JOSEPH_AND_ST_MARYS) {
+                double s = 0;
+                for(i = 0; i < t->numPlaces; i++) {
+                    int hops = t->hops[c][i];
+                    s += t->weight[i] *
+                         ((hops < nearest[i]) ? hops : nearest[i]);
+                }
+                if(best == NOWHERE || s < bestSpread) {
+                    best = c;
+                    bestSpread = s;
+                }
+            }
+        }
+
+        better = (numCentres == 0 || bestSpread < spread);
+        if(better) {
+            centres[numCentres++] = best;
+            spread = bestSpread;
+            for(i = 0; i < t->numPlaces; i++) {
+                if(t->hops[best][i] < nearest[i]) {
+                    nearest[i] = t->hops[best][i];
+                }
+            }
+        }
+    }
+    return numCentres;
+}
+
+// Puts each place into the region of its nearest centre; returns which
+// regions got anything, as bits
+static int splitPlaces(const Targets *t, const LocationID centres[],
+                       int numCentres, int regionOf[])
+{
+    int used = 0;
+    int i, r;
+    for(i = 0; i < t->numPlaces; i++) {
+        int best = 0;
+        for(r = 1; r < numCentres; r++) {
+            if(t->hops[centres[r]][i] < t->hops[centres[best]][i]) {
+                best = r;
+            }
+        }
+        regionOf[i] = best;
+        used |= 1 << best;
+    }
+    return used;
+}
+
+// The place with the least weighted hops to everywhere in region r
+static LocationID middleOf(const Targets *t, const int regionOf[], int r)
+{
+    LocationID best = NOWHERE;
+    double bestTotal = 0;
+    LocationID c;
+    for(c = MIN_MAP_LOCATION; c <= MAX_MAP_LOCATION; c++) {
+        if(c != ST_JOSEPH_AND_ST_MARYS) {
+            double total = 0;
+            int i;
+            for(i = 0; i < t->numPlaces; i++) {
+                if(regionOf[i] == r) {
+                    total += t->weight[i] * t->hops[c][i];
+                }
+            }
+            if(best == NOWHERE || total < bestTotal) {
+                best = c;
+                bestTotal = total;
+            }
+        }
+    }
+    return best;
+}
+
+// Tries every way of giving the hunters regions that leaves none out,
+// and keeps the one where the likely regions are reached soonest: least
+// weight times turns for each region's nearest hunter, and then least
+// turns for the hunters altogether
+static void chooseRoles(const LocationID hunters[NUM_HUNTERS], Round round,
+                        Roles *roles)
+{
+    int k = roles->numRegions;
+    int h;
+    for(h = 0; h < NUM_HUNTERS; h++) {
+        roles->role[h] = NO_ROLE;
+    }
+
+    if(k > 0) {
+        int turns[NUM_HUNTERS][MAX_REGIONS];
+        int r;
+        for(h = 0; h < NUM_HUNTERS; h++) {
+            for(r = 0; r < k; r++) {
+                turns[h][r] = turnsBetween(hunters[h], roles->centre[r],
+                                           h, round);
+            }
+        }
+
+        // each hunter's region, counted through like an odometer
+        int role[NUM_HUNTERS] = {0};
+        int first = TRUE;
+        double bestCost = 0;
+        int bestTotal = 0;
+        int done = FALSE;
+        while(!done) {
+            int soonest[MAX_REGIONS];
+            for(r = 0; r < k; r++) {
+                soonest[r] = NO_ROLE;
+            }
+            int total = 0;
+            for(h = 0; h < NUM_HUNTERS; h++) {
+                r = role[h];
+                if(soonest[r] == NO_ROLE || turns[h][r] < soonest[r]) {
+                    soonest[r] = turns[h][r];
+                }
+                total += turns[h][r];
+            }
+
+            int covered = TRUE;
+            double cost = 0;
+            for(r = 0; r < k; r++) {
+                if(soonest[r] == NO_ROLE) {
+                    covered = FALSE;
+                } else {
+                    cost += roles->weight[r] * soonest[r];
+                }
+            }
+
+            if(covered && (first || cost < bestCost ||
+                           (cost == bestCost && total < bestTotal))) {
+                for(h = 0; h < NUM_HUNTERS; h++) {
+                    roles->role[h] = role[h];
+                }
+                first = FALSE;
+                bestCost = cost;
+                bestTotal = total;
+            }
+
+            h = NUM_HUNTERS - 1;
+            role[h]++;
+            while(h > 0 && role[h] == k) {
+                role[h] = 0;
+                h--;
+                role[h]++;
+            }
+            done = (role[0] == k);
+        }
+    }
+}
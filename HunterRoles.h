@@ -0,0 +1,43 @@
+// HunterRoles.h ... sharing out the hunt between the hunters
+// Each hunter decides their own move, and left to themselves they all
+// head for the same likeliest place. Instead, where Dracula might be is
+// split into up to one region per hunter, and each hunter is given a
+// region to go after, so that between them the likely regions are
+// reached soonest
+// It's all done on the map's tables and from what every hunter knows
+// alike, with no randomness, so each hunter works out the same roles on
+// their own, in microseconds
+
+#ifndef HUNTER_ROLES_H
+#define HUNTER_ROLES_H
+
+#include "Globals.h"
+#include "Places.h"
+#include "LocationSet.h"
+
+#define MAX_REGIONS (NUM_PLAYERS - 1)
+
+// the role of a hunter when there's nothing to go after
+#define NO_ROLE -1
+
+typedef struct roles {
+    int numRegions;
+    LocationSet region[MAX_REGIONS];  // the places Dracula might be in each
+    LocationID centre[MAX_REGIONS];   // where to head for to cover each
+    double weight[MAX_REGIONS];       // how likely he is to be in each
+    int role[NUM_PLAYERS - 1];        // the region each hunter goes after
+} Roles;
+
+// assignRoles() splits the places with some weight (how likely Dracula is
+//   to be there, in any units) into regions, and gives each of the
+//   hunters, at the places in hunters[] and about to move in round, a
+//   region in roles
+// Every region gets a hunter; one with more goes to the region it gets
+//   to in the fewest turns. With no weight anywhere, there are no regions
+//   and every role is NO_ROLE
+
+void assignRoles(const double weight[NUM_MAP_LOCATIONS],
+                 const LocationID hunters[NUM_PLAYERS - 1], Round round,
+                 Roles *roles);
+
+#endif
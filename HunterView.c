@@ -8,46 +8,50 @@
 #include "Game.h"
 #include "GameView.h"
 #include "HunterView.h"
+#include "DracBelief.h"
+#include "DracDist.h"
+#include "TrailEnum.h"
 // #include "Map.h" ... if you decide to use the Map ADT
  
-// pastPlays string
-// the number characters used to describe each play
-#define CHARS_PER_PLAY 7
-
-// including the space
-#define CHARS_PER_PLAY_BLOCK (CHARS_PER_PLAY+1)
-
-// The maximum number of plays we will accept
-// Since each dracula turn reduces the score by one, we will set it to
-// at most 366 dracula's turns
-// ... plus a bit extra because josh is ultra-conservative
-#define MAX_PLAYS (366*5+5+10)
-
-// maximum length of past plays string
-#define MAX_PAST_PLAYS_LENGTH (MAX_PLAYS * CHARS_PER_PLAY_BLOCK)
-
 // most recent location in trail
 #define LAST_TRAIL_LOC_INDEX 0
 
-// index that the location abbreviation starts in within the char *pastPlays
-#define LOC_ABBREV_INDEX 1
-
 // id of the first round
 #define FIRST_ROUND 0
 
+// where the particles' random numbers start, so the same plays always
+// give the same distribution
+#define DIST_SEED 1927
+
 struct hunterView {
+    // the GameView also keeps Dracula's trail as best as we know it
     GameView g;
-    
-    // Dracula's last TRAIL_SIZE _locations_; NOT moves in REVERSE
-    // chronological order [as best as we know]
-    LocationID trailLocs[TRAIL_SIZE];
+
+    // everywhere he might be, worked out from every play
+    DracBelief belief;
+
+    // and how likely each of those is; NULL until someone asks
+    DracDist dist;
 };
      
 // helper functions
-static void pushOnTrailLocs (HunterView d, LocationID placeID);
+static HunterView makeHunterView(char *pastPlays, PlayerMessage messages[], int borrow);
+static void addToBelief(HunterView h, Round round, PlayerID player);
+static LocationID whereIsDracula(HunterView h);
 
 // Creates a new HunterView to summarise the current state of the game
 HunterView newHunterView(char *pastPlays, PlayerMessage messages[])
+{
+    return makeHunterView(pastPlays, messages, FALSE);
+}
+
+// Creates a new HunterView that reads pastPlays and messages in place
+HunterView newHunterViewBorrowed(char *pastPlays, PlayerMessage messages[])
+{
+    return makeHunterView(pastPlays, messages, TRUE);
+}
+
+static HunterView makeHunterView(char *pastPlays, PlayerMessage messages[], int borrow)
 {
     assert(pastPlays != NULL);
     assert(messages != NULL);
@@ -58,72 +62,53 @@ HunterView newHunterView(char *pastPlays, PlayerMessage messages[])
     assert(hunterView != NULL);
 
     // setup the gameview
-    hunterView->g = newGameView(pastPlays, messages);
+    hunterView->g = (borrow == TRUE) ?
+        newGameViewBorrowed(pastPlays, messages) :
+        newGameView(pastPlays, messages);
 
     assert(hunterView->g != NULL);
 
-    int i;
-
-    // initialise Dracula's actual locations to all UNKNOWN_LOCATION
-    for(i=0;i<TRAIL_SIZE;i++) {
-        hunterView->trailLocs[i] = UNKNOWN_LOCATION;
-    }
+    // go over every play so far for what it says about dracula
+    hunterView->belief = newDracBelief();
+    hunterView->dist = NULL;
 
-    // length of pastPlays
-    int pastPlaysLength = strnlen(pastPlays, MAX_PAST_PLAYS_LENGTH); 
-
-    // iterate over each turn and process
-    for(i=0;i<pastPlaysLength;i+=CHARS_PER_PLAY_BLOCK) {
-        // get curPlayer
-        PlayerID curPlayer = ( (i/CHARS_PER_PLAY_BLOCK) % NUM_PLAYERS);
-
-        // ensure it's dracula
-        if(curPlayer == PLAYER_DRACULA) {
-            // try to get current loc (if it's exact)
-            LocationID curLoc = abbrevToID(pastPlays+i+LOC_ABBREV_INDEX);
-
-//            fprintf(stderr,"here = %.7s curLoc = %d\n",pastPlays+i,curLoc);
-
-            // test if exact location
-            if(!validPlace(curLoc)) {
-                // not exact; try to use trail to work out where we really are
-
-                // either a HIDE, DOUBLE_BACK_ or TELEPORT
-                if(pastPlays[i+LOC_ABBREV_INDEX] == 'H') {
-                    // HIDE: go to most recent location
-                    curLoc = hunterView->trailLocs[LAST_TRAIL_LOC_INDEX];
-                } else if(pastPlays[i+LOC_ABBREV_INDEX] == 'D') {
-                    // DOUBLE BACK
-                    int numBack = (int)(pastPlays[i+LOC_ABBREV_INDEX+1]-'0');
-                    curLoc = hunterView->trailLocs[numBack];
-                } else if(pastPlays[i+LOC_ABBREV_INDEX] == 'T') {
-                    // TELEPORT back to CASTLE_DRACULA
-                    curLoc = CASTLE_DRACULA;
-                } else if(pastPlays[i+LOC_ABBREV_INDEX] == 'C') {
-                    curLoc = CITY_UNKNOWN;
-                } else if(pastPlays[i+LOC_ABBREV_INDEX] == 'S') {
-                    curLoc = SEA_UNKNOWN;
-                } else {
-                    curLoc = UNKNOWN_LOCATION;
-                }
-            }
-
-            // push curLoc onto the trail
-            pushOnTrailLocs(hunterView, curLoc);
-        }
+    int numTurns = getRound(hunterView->g) * NUM_PLAYERS +
+                   getCurrentPlayer(hunterView->g);
+    int turn;
+    for(turn = 0; turn < numTurns; turn++) {
+        addToBelief(hunterView, turn / NUM_PLAYERS, turn % NUM_PLAYERS);
     }
 
     return hunterView;
 }
  
      
+// Adds one more play to the end of an existing HunterView
+void appendHunterPlay(HunterView currentView, const char *play,
+                      PlayerMessage message)
+{
+    assert(currentView != NULL);
+    assert(play != NULL);
+
+    // whoever's turn it was made this play
+    Round round = getRound(currentView->g);
+    PlayerID player = getCurrentPlayer(currentView->g);
+
+    appendPlay(currentView->g, play, message);
+    addToBelief(currentView, round, player);
+}
+
 // Frees all memory previously allocated for the HunterView toBeDeleted
 void disposeHunterView(HunterView toBeDeleted)
 {
     assert(toBeDeleted != NULL);
 
-    // drop the gameview
+    // drop the gameview and what we believe
     disposeGameView(toBeDeleted->g);
+    disposeDracBelief(toBeDeleted->belief);
+    if(toBeDeleted->dist != NULL) {
+        disposeDracDist(toBeDeleted->dist);
+    }
 
     // free ourselves
     free( toBeDeleted );
@@ -173,13 +158,7 @@ LocationID whereIs(HunterView currentView, PlayerID player)
 
     // check if dracula
     if(player == PLAYER_DRACULA) {
-        // use our trail thing mwahahahaha [if it's not unnown]
-        ret = currentView->trailLocs[LAST_TRAIL_LOC_INDEX];
-
-        if(ret == UNKNOWN_LOCATION) {
-            // ok we'll use the adt
-            ret = getLocation(currentView->g, player);
-        }
+        ret = whereIsDracula(currentView);
     } else {
         // use adt
         ret = getLocation(currentView->g, player);
@@ -188,6 +167,159 @@ LocationID whereIs(HunterView currentView, PlayerID player)
     return ret;
 }
 
+// Get everywhere Dracula might be now
+LocationSet whereMightDraculaBe(HunterView currentView)
+{
+    assert(currentView != NULL);
+    return possibleLocations(currentView->belief, LAST_TRAIL_LOC_INDEX);
+}
+
+// Get everywhere Dracula might have been some turns ago
+LocationSet whereMightDraculaHaveBeen(HunterView currentView, int turnsAgo)
+{
+    assert(currentView != NULL);
+    assert(0 <= turnsAgo && turnsAgo < TRAIL_SIZE);
+    return possibleLocations(currentView->belief, turnsAgo);
+}
+
+// Start keeping a probability for each place Dracula might be
+void trackDracula(HunterView currentView, int numParticles,
+                  DracMoveModel model, void *modelData)
+{
+    assert(currentView != NULL);
+    assert(numParticles >= 0);
+
+    if(currentView->dist != NULL) {
+        disposeDracDist(currentView->dist);
+    }
+    currentView->dist =
+        newDracDist(numParticles, model, modelData, DIST_SEED);
+
+    // catch up; the distribution needs to see the belief as it was after
+    // each play, so go over them again with a belief of its own
+    DracBelief belief = newDracBelief();
+
+    int numTurns = getRound(currentView->g) * NUM_PLAYERS +
+                   getCurrentPlayer(currentView->g);
+    int turn;
+    for(turn = 0; turn < numTurns; turn++) {
+        int n;
+        const PlayRecord *play =
+            getFullHistory(currentView->g, turn % NUM_PLAYERS,
+                           turn / NUM_PLAYERS, turn / NUM_PLAYERS + 1, &n);
+        updateBelief(belief, play);
+        updateDist(currentView->dist, play, belief);
+    }
+
+    disposeDracBelief(belief);
+}
+
+// What every hunter knew at the start of this round
+void giveMeTheRoundStart(HunterView currentView,
+                         double weight[NUM_MAP_LOCATIONS],
+                         LocationID hunters[PLAYER_DRACULA])
+{
+    assert(currentView != NULL);
+
+    // go over every play up to Dracula's last, as trackDracula() does
+    DracBelief belief = newDracBelief();
+    DracDist dist = newDracDist(DIST_EXACT, NULL, NULL, DIST_SEED);
+
+    Round round = getRound(currentView->g);
+    int numTurns = round * NUM_PLAYERS;
+    int turn;
+    for(turn = 0; turn < numTurns; turn++) {
+        int n;
+        const PlayRecord *play =
+            getFullHistory(currentView->g, turn % NUM_PLAYERS,
+                           turn / NUM_PLAYERS, turn / NUM_PLAYERS + 1, &n);
+        updateBelief(belief, play);
+        updateDist(dist, play, belief);
+    }
+
+    LocationID v;
+    for(v = MIN_MAP_LOCATION; v <= MAX_MAP_LOCATION; v++) {
+        weight[v] = (round > FIRST_ROUND) ? distProbability(dist, v) : 0;
+    }
+    disposeDracDist(dist);
+    disposeDracBelief(belief);
+
+    PlayerID h;
+    for(h = 0; h < PLAYER_DRACULA; h++) {
+        hunters[h] = NOWHERE;
+        if(round > FIRST_ROUND) {
+            int n;
+            const PlayRecord *play =
+                getFullHistory(currentView->g, h, round - 1, round, &n);
+            hunters[h] = (play->encounters & ENCOUNTER_HOSPITAL) ?
+                         ST_JOSEPH_AND_ST_MARYS : play->location;
+        }
+    }
+}
+
+// Get the probability Dracula is at where
+double probabilityAt(HunterView currentView, LocationID where)
+{
+    assert(currentView != NULL);
+    assert(validPlace(where));
+
+    if(currentView->dist == NULL) {
+        trackDracula(currentView, DIST_EXACT, NULL, NULL);
+    }
+    return distProbability(currentView->dist, where);
+}
+
+// Get the most likely places for Dracula
+int mostLikelyLocations(HunterView currentView, int k, LocationID locs[])
+{
+    assert(currentView != NULL);
+
+    if(currentView->dist == NULL) {
+        trackDracula(currentView, DIST_EXACT, NULL, NULL);
+    }
+    return distTopK(currentView->dist, k, locs);
+}
+
+// Pick a place for Dracula, as likely as we think it is
+LocationID sampleDraculaLocation(HunterView currentView, RandomState *rng)
+{
+    assert(currentView != NULL);
+
+    if(currentView->dist == NULL) {
+        trackDracula(currentView, DIST_EXACT, NULL, NULL);
+    }
+    return distSample(currentView->dist, rng);
+}
+
+// Go through every trail Dracula could have left
+TrailEnum possibleTrails(HunterView currentView, int maxStored)
+{
+    assert(currentView != NULL);
+
+    // his last TRAIL_SIZE moves, most recent first
+    LocationID moves[TRAIL_SIZE];
+    Round round = giveMeTheRound(currentView);
+    int n;
+    const PlayRecord *played = getFullHistory(currentView->g, PLAYER_DRACULA,
+        (round > TRAIL_SIZE) ? round - TRAIL_SIZE : FIRST_ROUND, round, &n);
+
+    int i;
+    for(i = 0; i < TRAIL_SIZE; i++) {
+        moves[i] = (i < n) ? played[n-1-i].move : NOWHERE;
+    }
+
+    return newTrailEnum(moves, currentView->belief, maxStored);
+}
+
+// The game as the hunters see it, for searching
+void giveMeTheState(HunterView currentView, GameState *state)
+{
+    assert(currentView != NULL);
+    assert(state != NULL);
+
+    getGameState(currentView->g, state);
+}
+
 //// Functions that return information about the history of the game
 
 // Fills the trail array with the location ids of the last 6 turns
@@ -206,25 +338,34 @@ void giveMeTheTrail(HunterView currentView, PlayerID player,
 // What are my possible next moves (locations)
 LocationID *whereCanIgo(HunterView currentView, int *numLocations, int road, int rail, int sea)
 {
-    assert(currentView != NULL);
     assert(numLocations != NULL);
 
+    LocationSet canGo = whereCanIgoSet(currentView, road, rail, sea);
+
     // return value
-    LocationID *ret;
+    LocationID *ret =
+        (LocationID *)(malloc(sizeof(LocationID)*NUM_MAP_LOCATIONS));
+    assert(ret != NULL);
+
+    (*numLocations) = setToArray(canGo, ret);
+    
+    return ret;
+}
+
+// What are my possible next moves, as a set
+LocationSet whereCanIgoSet(HunterView currentView, int road, int rail, int sea)
+{
+    assert(currentView != NULL);
+
+    // return value
+    LocationSet ret;
 
     // check if first round
     if(getRound(currentView->g) == FIRST_ROUND) {
         // everywhere!
-        ret = (LocationID *)(malloc(sizeof(LocationID)*NUM_MAP_LOCATIONS));
-        (*numLocations) = 0;
-
-        int i;
-        for(i=0;i<NUM_MAP_LOCATIONS;i++) {
-            ret[(*numLocations)] = i;
-            (*numLocations)++;
-        }
+        ret = setAll();
     } else {
-        ret = connectedLocations(currentView->g, numLocations,
+        ret = connectedLocationsSet(currentView->g,
                                  getLocation(currentView->g, 
                                              getCurrentPlayer(currentView->g)),
                                  getCurrentPlayer(currentView->g),
@@ -243,6 +384,37 @@ LocationID *whereCanTheyGo(HunterView currentView, int *numLocations,
     assert(0 <= player && player < NUM_PLAYERS);
     assert(numLocations != NULL);
 
+    // return value
+    LocationID *ret;
+
+    // see if we can infer dracula's location
+    if(player == PLAYER_DRACULA &&
+       giveMeTheRound(currentView) != FIRST_ROUND &&
+       !validPlace(whereIs(currentView, PLAYER_DRACULA))) {
+        // we're only meant to answer if we know exactly where he is;
+        // whereCanTheyGoSet() goes further, from everywhere he might be
+        (*numLocations) = 0;
+        ret = NULL;
+    } else {
+        LocationSet canGo =
+            whereCanTheyGoSet(currentView, player, road, rail, sea);
+
+        ret = (LocationID *)(malloc(sizeof(LocationID)*NUM_MAP_LOCATIONS));
+        assert(ret != NULL);
+
+        (*numLocations) = setToArray(canGo, ret);
+    }
+
+    return ret;
+}
+
+// What are the specified player's next possible moves, as a set
+LocationSet whereCanTheyGoSet(HunterView currentView, PlayerID player,
+                              int road, int rail, int sea)
+{
+    assert(currentView != NULL);
+    assert(0 <= player && player < NUM_PLAYERS);
+
     Round theirNextRound;
 
     // check if they're before or after me
@@ -253,21 +425,16 @@ LocationID *whereCanTheyGo(HunterView currentView, int *numLocations,
     }
 
     // return value
-    LocationID *ret;
+    LocationSet ret;
 
     // check if first round
     if(theirNextRound == FIRST_ROUND) {
-        ret = (LocationID *)(malloc(sizeof(LocationID)*NUM_MAP_LOCATIONS));
-        (*numLocations) = 0;
-
         // everywhere! 
-        int i;
-        for(i=0;i<NUM_MAP_LOCATIONS;i++) {
-            // dracula can go everywhere except ST_JOSEPH_AND_ST_MARYS
-            if(player != PLAYER_DRACULA || i != ST_JOSEPH_AND_ST_MARYS) {
-                ret[(*numLocations)] = i;
-                (*numLocations)++;
-            }
+        ret = setAll();
+
+        // dracula can go everywhere except ST_JOSEPH_AND_ST_MARYS
+        if(player == PLAYER_DRACULA) {
+            setRemove(&ret, ST_JOSEPH_AND_ST_MARYS);
         }
     } else {
         if(player == PLAYER_DRACULA) {
@@ -280,35 +447,66 @@ LocationID *whereCanTheyGo(HunterView currentView, int *numLocations,
             // if valid, do the usual
             if(validPlace(dracLoc)) {
                 // dracula can't travel by rail even if he wants to
-                ret = connectedLocations(currentView->g, numLocations,
-                                        whereIs(currentView, PLAYER_DRACULA),
-                                        theirNextRound,
-                                        player, road, FALSE, sea);
+                ret = connectedLocationsSet(currentView->g, dracLoc,
+                                        player, theirNextRound,
+                                        road, FALSE, sea);
             } else {
-                (*numLocations) = 0;
-
-                // FIXME not sure what to return; probably doesn't matter
-                ret = NULL;
+                // everywhere he might get to from everywhere he might be
+                LocationSet mightBe = possibleLocations(currentView->belief, 0);
+                ret = setEmpty();
+
+                LocationID v;
+                for(v = setNext(mightBe, 0); v != NOWHERE;
+                    v = setNext(mightBe, v+1)) {
+                    ret = setUnion(ret,
+                        connectedLocationsSet(currentView->g, v,
+                                              player, theirNextRound,
+                                              road, FALSE, sea));
+                }
             }
         } else {
             // a hunter
-            ret =  connectedLocations(currentView->g, numLocations,
+            ret = connectedLocationsSet(currentView->g,
                                     getLocation(currentView->g, player),
-                                    theirNextRound,
-                                    player, road, rail, sea);
+                                    player, theirNextRound,
+                                    road, rail, sea);
         }
     }
 
     return ret;
 }
 
-static void pushOnTrailLocs (HunterView h, LocationID placeID) {
-    assert(h != NULL);
+// Tells the belief about the play made by player in round
+static void addToBelief(HunterView h, Round round, PlayerID player)
+{
+    int n;
+    const PlayRecord *play =
+        getFullHistory(h->g, player, round, round+1, &n);
+    assert(n == 1);
+
+    updateBelief(h->belief, play);
+    if(h->dist != NULL) {
+        updateDist(h->dist, play, h->belief);
+    }
+}
 
-    int i;
-    for(i=TRAIL_SIZE-1; i>=1; i--) {
-        h->trailLocs[i] = h->trailLocs[i-1];
+// Where dracula is, as precisely as we can tell
+static LocationID whereIsDracula(HunterView h)
+{
+    // use our trail thing mwahahahaha [if it's not unnown]
+    LocationID trailLocs[TRAIL_SIZE];
+    getTrailLocations(h->g, trailLocs);
+    LocationID ret = trailLocs[LAST_TRAIL_LOC_INDEX];
+
+    // the belief may have pinned him down even if the plays don't say
+    LocationSet mightBe = possibleLocations(h->belief, LAST_TRAIL_LOC_INDEX);
+    if(!validPlace(ret) && setSize(mightBe) == 1) {
+        ret = setNext(mightBe, 0);
+    }
+
+    if(ret == UNKNOWN_LOCATION) {
+        // ok we'll use the adt
+        ret = getLocation(h->g, PLAYER_DRACULA);
     }
-    h->trailLocs[0] = placeID;
-    return;
+    return ret;
 }
@@ -8,6 +8,11 @@
 #include "Globals.h"
 #include "Game.h"
 #include "Places.h"
+#include "LocationSet.h"
+#include "GameState.h"
+#include "DracDist.h"
+#include "Random.h"
+#include "TrailEnum.h"
 
 typedef struct hunterView *HunterView;
 
@@ -31,6 +36,20 @@ typedef struct hunterView *HunterView;
 
 HunterView newHunterView(char *pastPlays, PlayerMessage messages[]);
 
+// newHunterViewBorrowed() reads pastPlays and messages in place instead of
+// copying them; the caller must keep both alive and unchanged until the
+// view is disposed of (see newGameViewBorrowed() in GameView.h)
+
+HunterView newHunterViewBorrowed(char *pastPlays, PlayerMessage messages[]);
+
+
+// appendHunterPlay() brings an existing HunterView up to date with one
+// more play, without reparsing the plays it has already seen
+// (see appendPlay() in GameView.h)
+
+void appendHunterPlay(HunterView currentView, const char *play,
+                      PlayerMessage message);
+
 
 // disposeHunterView() frees all memory previously allocated for the HunterView
 // toBeDeleted. toBeDeleted should not be accessed after the call.
@@ -66,9 +85,80 @@ int howHealthyIs(HunterView currentView, PlayerID player);
 //   know Dracula's precise location, return the appropriate
 //   X_UNKNOWN (where X is CITY or SEA) if that much can be determined,
 //   else simply return UNKNOWN_LOCATION
+// (Dracula's location counts as precise if everything the hunters have
+//   seen leaves only one place he can be; see whereMightDraculaBe())
 
 LocationID whereIs(HunterView currentView, PlayerID player);
 
+// whereMightDraculaBe() gives every location Dracula could be at now,
+//   given every play so far: where he was revealed, land or sea, HIDE and
+//   DOUBLE_BACK_N, where he could have moved, and where hunters have been
+//   without running into him
+// It's kept up to date as plays come in, so asking costs nothing
+
+LocationSet whereMightDraculaBe(HunterView currentView);
+
+// whereMightDraculaHaveBeen() gives the same for turnsAgo of Dracula's
+//   turns ago, in the interval [0...TRAIL_SIZE-1] (0 is now)
+// Empty if he hadn't had that many turns yet
+
+LocationSet whereMightDraculaHaveBeen(HunterView currentView, int turnsAgo);
+
+// trackDracula() starts keeping a probability for each place Dracula
+//   might be, on top of whereMightDraculaBe()
+// numParticles is DIST_EXACT for an exact weight on every location, or
+//   how many particles (guesses at his whole trail) to follow
+// model says how likely he is to make each move, NULL if every legal
+//   move is as likely (see DracDist.h); modelData is passed on to it
+// The plays so far are taken into account straight away, and each
+//   appendHunterPlay() after that costs a few microseconds more
+// Calling it again starts over with the new settings
+
+void trackDracula(HunterView currentView, int numParticles,
+                  DracMoveModel model, void *modelData);
+
+// probabilityAt() gives the probability that Dracula is at where now
+// If trackDracula() hasn't been called, this (and the two below) start
+//   tracking exactly, with every legal move as likely
+
+double probabilityAt(HunterView currentView, LocationID where);
+
+// mostLikelyLocations() puts the (up to) k most likely places for Dracula
+//   into locs[], most likely first, and returns how many there were
+
+int mostLikelyLocations(HunterView currentView, int k, LocationID locs[]);
+
+// sampleDraculaLocation() picks a place for Dracula at random, as likely
+//   as probabilityAt() says; NOWHERE if he hasn't moved yet
+
+LocationID sampleDraculaLocation(HunterView currentView, RandomState *rng);
+
+// possibleTrails() goes through every 6-place trail Dracula could have
+//   left, given every play so far (see TrailEnum.h for what you can ask)
+// Keeps the trails if there are no more than maxStored of them
+// The caller must dispose of the result with disposeTrailEnum()
+
+TrailEnum possibleTrails(HunterView currentView, int maxStored);
+
+// giveMeTheState() fills state with the game as the hunters see it, for
+//   a search to play moves on (see GameState.h)
+// Dracula's trail is as well as the plays show it (CITY_UNKNOWN and so
+//   on), so a search has to fill it in first, say from possibleTrails()
+
+void giveMeTheState(HunterView currentView, GameState *state);
+
+// giveMeTheRoundStart() gives what every hunter knew at the start of this
+//   round, before any of us moved in it: in weight[], how likely Dracula
+//   was to be at each location (exactly, with every legal move as likely),
+//   and in hunters[], where each hunter's last play had taken them
+// Every hunter gets the same answer all round, whatever's been played
+//   since, so it's something we can all agree on without talking
+// Before Dracula's first move, every weight is zero
+
+void giveMeTheRoundStart(HunterView currentView,
+                         double weight[NUM_MAP_LOCATIONS],
+                         LocationID hunters[PLAYER_DRACULA]);
+
 
 //// Functions that return information about the history of the game
 
@@ -100,6 +190,11 @@ void giveMeTheTrail(HunterView currentView, PlayerID player,
 LocationID *whereCanIgo(HunterView currentView, int *numLocations,
                         int road, int rail, int sea);
 
+// whereCanIgoSet() gives the same locations as whereCanIgo() as a
+//   LocationSet; nothing is allocated
+
+LocationSet whereCanIgoSet(HunterView currentView, int road, int rail, int sea);
+
 // whereCanTheyGo() returns an array of LocationIDs giving all of the
 //   locations that the given Player could reach from their current location
 // road, rail and sea are connections should only be considered
@@ -113,5 +208,13 @@ LocationID *whereCanIgo(HunterView currentView, int *numLocations,
 LocationID *whereCanTheyGo(HunterView currentView, int *numLocations,
                            PlayerID player, int road, int rail, int sea);
 
+// whereCanTheyGoSet() gives the same locations as whereCanTheyGo() as a
+//   LocationSet; nothing is allocated
+// If the given player is Dracula and his location isn't known precisely,
+//   the set has everywhere he could get to from anywhere he might be
+
+LocationSet whereCanTheyGoSet(HunterView currentView, PlayerID player,
+                              int road, int rail, int sea);
+
 
 #endif
@@ -0,0 +1,147 @@
+// LocationSet.h ... a set of map locations packed into two 64-bit words
+// Everything here is inline; sets are small enough to pass by value
+//
+// Every map location fits in one set, so whole-set operations (union,
+// intersection, size, ...) are a couple of instructions each. Use these
+// instead of nested loops over LocationID arrays.
+
+#ifndef LOCATION_SET_H
+#define LOCATION_SET_H
+
+#include <stdint.h>
+#include "Places.h"
+
+#define SET_WORD_BITS 64
+#define SET_WORDS 2
+
+typedef struct locationSet {
+    uint64_t bits[SET_WORDS];
+} LocationSet;
+
+// the set with nothing in it
+static inline LocationSet setEmpty(void)
+{
+    LocationSet s = {{0, 0}};
+    return s;
+}
+
+// the set of every real map location
+static inline LocationSet setAll(void)
+{
+    LocationSet s = {{~(uint64_t)0,
+                      ((uint64_t)1 << (NUM_MAP_LOCATIONS - SET_WORD_BITS)) - 1}};
+    return s;
+}
+
+// the set containing just v
+static inline LocationSet setOf(LocationID v)
+{
+    LocationSet s = {{0, 0}};
+    s.bits[v / SET_WORD_BITS] = (uint64_t)1 << (v % SET_WORD_BITS);
+    return s;
+}
+
+// add location v to the set
+static inline void setAdd(LocationSet *s, LocationID v)
+{
+    s->bits[v / SET_WORD_BITS] |= (uint64_t)1 << (v % SET_WORD_BITS);
+}
+
+// take location v out of the set
+static inline void setRemove(LocationSet *s, LocationID v)
+{
+    s->bits[v / SET_WORD_BITS] &= ~((uint64_t)1 << (v % SET_WORD_BITS));
+}
+
+// is location v in the set?
+static inline int setHas(LocationSet s, LocationID v)
+{
+    return (int)((s.bits[v / SET_WORD_BITS] >> (v % SET_WORD_BITS)) & 1);
+}
+
+// everything in a or b
+static inline LocationSet setUnion(LocationSet a, LocationSet b)
+{
+    LocationSet s = {{a.bits[0] | b.bits[0], a.bits[1] | b.bits[1]}};
+    return s;
+}
+
+// everything in both a and b
+static inline LocationSet setIntersect(LocationSet a, LocationSet b)
+{
+    LocationSet s = {{a.bits[0] & b.bits[0], a.bits[1] & b.bits[1]}};
+    return s;
+}
+
+// everything in a but not in b
+static inline LocationSet setMinus(LocationSet a, LocationSet b)
+{
+    LocationSet s = {{a.bits[0] & ~b.bits[0], a.bits[1] & ~b.bits[1]}};
+    return s;
+}
+
+static inline int setIsEmpty(LocationSet s)
+{
+    return (s.bits[0] | s.bits[1]) == 0;
+}
+
+static inline int setEquals(LocationSet a, LocationSet b)
+{
+    return a.bits[0] == b.bits[0] && a.bits[1] == b.bits[1];
+}
+
+// is every location in a also in b?
+static inline int setIsSubset(LocationSet a, LocationSet b)
+{
+    return ((a.bits[0] & ~b.bits[0]) | (a.bits[1] & ~b.bits[1])) == 0;
+}
+
+// number of locations in the set
+static inline int setSize(LocationSet s)
+{
+    return __builtin_popcountll(s.bits[0]) + __builtin_popcountll(s.bits[1]);
+}
+
+// smallest location in the set that is >= from, or NOWHERE if there is none
+// iterate with: for (v = setNext(s, 0); v != NOWHERE; v = setNext(s, v+1))
+static inline LocationID setNext(LocationSet s, LocationID from)
+{
+    LocationID ret = NOWHERE;
+    int w = from / SET_WORD_BITS;
+    if (w < SET_WORDS) {
+        uint64_t rest = s.bits[w] & (~(uint64_t)0 << (from % SET_WORD_BITS));
+        while (rest == 0 && ++w < SET_WORDS) rest = s.bits[w];
+        if (rest != 0) ret = w * SET_WORD_BITS + __builtin_ctzll(rest);
+    }
+    return ret;
+}
+
+
+// copy the set into out[] in increasing order and return how many there are
+// out must have room for setSize(s) entries
+static inline int setToArray(LocationSet s, LocationID out[])
+{
+    int n = 0, w;
+    for (w = 0; w < SET_WORDS; w++) {
+        uint64_t rest = s.bits[w];
+        while (rest != 0) {
+            out[n++] = w * SET_WORD_BITS + __builtin_ctzll(rest);
+            rest &= rest - 1;
+        }
+    }
+    return n;
+}
+
+// the set of the first n entries of locs; entries that aren't real map
+// locations (NOWHERE, CITY_UNKNOWN, HIDE, ...) are skipped
+static inline LocationSet setFromArray(const LocationID locs[], int n)
+{
+    LocationSet s = {{0, 0}};
+    int i;
+    for (i = 0; i < n; i++) {
+        if (validPlace(locs[i])) setAdd(&s, locs[i]);
+    }
+    return s;
+}
+
+#endif
@@ -6,109 +6,25 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "Map.h"
+#include "MapData.h"
 #include "Places.h"
 
-typedef struct vNode *VList;
-
-struct vNode {
-    LocationID  v;    // ALICANTE, etc
-    TransportID type; // ROAD, RAIL, BOAT
-    VList       next; // link to next node
-};
-
-struct MapRep {
-    int   nV;         // #vertices
-    int   nE;         // #edges
-    VList connections[NUM_MAP_LOCATIONS]; // array of lists
-
-    // immediate edges: num edges via each mode of transport
-    int adjmat[NUM_TRANSPORT][NUM_MAP_LOCATIONS][NUM_MAP_LOCATIONS];
-};
-
-static void addConnections(Map);
-
-// Create a new empty graph (for a map)
-// #Vertices always same as NUM_PLACES
-Map newMap()
+// Get the shared map; it is all generated at build time (see mkmap.c)
+Map getMap(void)
 {
-    int i, j, k;
-    Map g = malloc(sizeof(struct MapRep));
-    assert(g != NULL);
-    g->nV = NUM_MAP_LOCATIONS;
-    for (i = 0; i < g->nV; i++){
-        g->connections[i] = NULL;
-    }
-    g->nE = 0;
-
-    for(k=0;k<NUM_TRANSPORT;k++) {
-        for(i=0;i<g->nV;i++) {
-            for(j=0;j<g->nV;j++) {
-                g->adjmat[k][i][j] = NO_EDGE;
-            }
-            g->adjmat[k][i][i] = 0;
-        }
-    }
-    addConnections(g);
-    return g;
+    return &mapData;
 }
 
-// Remove an existing graph
-void destroyMap(Map g)
-{
-    int i;
-    VList curr;
-    VList next;
-    assert(g != NULL);
-    assert(g->connections != NULL);
-
-    for (i = 0; i < g->nV; i++){
-        curr = g->connections[i];
-        while(curr != NULL){
-            next = curr->next;
-            free(curr);
-            curr=next;
-        }
-    }
-    free(g);
-}
-
-static VList insertVList(VList L, LocationID v, TransportID type)
+// Kept for older callers: every "new" map is the shared one
+Map newMap()
 {
-    VList newV = malloc(sizeof(struct vNode));
-    newV->v = v;
-    newV->type = type;
-    newV->next = L;
-    return newV;
+    return getMap();
 }
 
-static int inVList(VList L, LocationID v, TransportID type)
+// Nothing to do; the shared map lives as long as the process
+void disposeMap(Map g)
 {
-    VList cur;
-    for (cur = L; cur != NULL; cur = cur->next) {
-        if (cur->v == v && cur->type == type) return 1;
-    }
-    return 0;
-}
-
-// Add a new edge to the Map/Graph
-void addLink(Map g, LocationID start, LocationID end, TransportID type)
-{
-    assert(g != NULL);
-    // don't add edges twice
-    if (!inVList(g->connections[start],end,type)) {
-        g->connections[start] = insertVList(g->connections[start],end,type);
-        g->connections[end] = insertVList(g->connections[end],start,type);
-        g->nE++;
-    }
-
-    if(g->adjmat[type][start][end] == NO_EDGE) {
-        g->adjmat[type][start][end] = 1;
-    }
-
-    // other way, too; undirected graph
-    if(g->adjmat[type][end][start] == NO_EDGE) {
-        g->adjmat[type][end][start] = 1;
-    }
+    assert(g == &mapData);
 }
 
 // Display content of Map/Graph
@@ -116,18 +32,18 @@ void showMap(Map g)
 {
     assert(g != NULL);
     printf("V=%d, E=%d\n", g->nV, g->nE);
-    int i;
+    int i, t, k;
     for (i = 0; i < g->nV; i++) {
-        VList n = g->connections[i];
-        while (n != NULL) {
-            printf("%s connects to %s ",idToName(i),idToName(n->v));
-            switch (n->type) {
-                case ROAD: printf("by road\n"); break;
-                case RAIL: printf("by rail\n"); break;
-                case BOAT: printf("by boat\n"); break;
-                default:   printf("by ????\n"); break;
+        for (t = MIN_TRANSPORT; t <= MAX_TRANSPORT; t++) {
+            for (k = g->first[t][i]; k < g->first[t][i+1]; k++) {
+                printf("%s connects to %s ",idToName(i),idToName(g->arcs[t][k]));
+                switch (t) {
+                    case ROAD: printf("by road\n"); break;
+                    case RAIL: printf("by rail\n"); break;
+                    case BOAT: printf("by boat\n"); break;
+                    default:   printf("by ????\n"); break;
+                }
             }
-            n = n->next;
         }
     }
 }
@@ -140,16 +56,15 @@ int numV(Map g)
 }
 
 // Return count of edges of a particular type
+// (each edge is counted from both ends; ANY counts every transport)
 int numE(Map g, TransportID type)
 {
-    int i, nE=0;
+    int t, nE = 0;
     assert(g != NULL);
     assert(type >= 0 && type <= ANY);
-    for (i = 0; i < g->nV; i++) {
-        VList n = g->connections[i];
-        while (n != NULL) {
-            if (n->type == type || type == ANY) nE++;
-            n = n->next;
+    for (t = MIN_TRANSPORT; t <= MAX_TRANSPORT; t++) {
+        if (t == type || type == ANY) {
+            nE += g->first[t][NUM_MAP_LOCATIONS];
         }
     }
     return nE;
@@ -158,216 +73,134 @@ int numE(Map g, TransportID type)
 // returns the distance of a direct edge of transport t FROM a TO b
 // or NO_EDGE if no such edge exists
 int  getDist(Map g, TransportID t, LocationID a, LocationID b) {
-    return g->adjmat[t][a][b];
+    int ret = NO_EDGE;
+    assert(g != NULL);
+    assert(t >= 0 && t <= ANY);
+    if (a == b) {
+        ret = 0;
+    } else if (setHas(g->adj[t][a], b)) {
+        ret = 1;
+    }
+    return ret;
 }
 
-// Add edges to Graph representing map of Europe
-static void addConnections(Map g)
+// returns the fewest edges of transport t needed to get FROM a TO b
+// or NO_PATH if b can't be reached that way
+int  getHops(TransportID t, LocationID a, LocationID b)
 {
-    //### ROAD Connections ###
+    assert(t >= 0 && t <= ANY);
+    assert(validPlace(a) && validPlace(b));
+    return getMap()->hops[t][a][b];
+}
 
-    addLink(g, ALICANTE, GRANADA, ROAD);
-    addLink(g, ALICANTE, MADRID, ROAD);
-    addLink(g, ALICANTE, SARAGOSSA, ROAD);
-    addLink(g, AMSTERDAM, BRUSSELS, ROAD);
-    addLink(g, AMSTERDAM, COLOGNE, ROAD);
-    addLink(g, ATHENS, VALONA, ROAD);
-    addLink(g, BARCELONA, SARAGOSSA, ROAD);
-    addLink(g, BARCELONA, TOULOUSE, ROAD);
-    addLink(g, BARI, NAPLES, ROAD);
-    addLink(g, BARI, ROME, ROAD);
-    addLink(g, BELGRADE, BUCHAREST, ROAD);
-    addLink(g, BELGRADE, KLAUSENBURG, ROAD);
-    addLink(g, BELGRADE, SARAJEVO, ROAD);
-    addLink(g, BELGRADE, SOFIA, ROAD);
-    addLink(g, BELGRADE, ST_JOSEPH_AND_ST_MARYS, ROAD);
-    addLink(g, BELGRADE, SZEGED, ROAD);
-    addLink(g, BERLIN, HAMBURG, ROAD);
-    addLink(g, BERLIN, LEIPZIG, ROAD);
-    addLink(g, BERLIN, PRAGUE, ROAD);
-    addLink(g, BORDEAUX, CLERMONT_FERRAND, ROAD);
-    addLink(g, BORDEAUX, NANTES, ROAD);
-    addLink(g, BORDEAUX, SARAGOSSA, ROAD);
-    addLink(g, BORDEAUX, TOULOUSE, ROAD);
-    addLink(g, BRUSSELS, COLOGNE, ROAD);
-    addLink(g, BRUSSELS, LE_HAVRE, ROAD);
-    addLink(g, BRUSSELS, PARIS, ROAD);
-    addLink(g, BRUSSELS, STRASBOURG, ROAD);
-    addLink(g, BUCHAREST, CONSTANTA, ROAD);
-    addLink(g, BUCHAREST, GALATZ, ROAD);
-    addLink(g, BUCHAREST, KLAUSENBURG, ROAD);
-    addLink(g, BUCHAREST, SOFIA, ROAD);
-    addLink(g, BUDAPEST, KLAUSENBURG, ROAD);
-    addLink(g, BUDAPEST, SZEGED, ROAD);
-    addLink(g, BUDAPEST, VIENNA, ROAD);
-    addLink(g, BUDAPEST, ZAGREB, ROAD);
-    addLink(g, CADIZ, GRANADA, ROAD);
-    addLink(g, CADIZ, LISBON, ROAD);
-    addLink(g, CADIZ, MADRID, ROAD);
-    addLink(g, CASTLE_DRACULA, GALATZ, ROAD);
-    addLink(g, CASTLE_DRACULA, KLAUSENBURG, ROAD);
-    addLink(g, CLERMONT_FERRAND, GENEVA, ROAD);
-    addLink(g, CLERMONT_FERRAND, MARSEILLES, ROAD);
-    addLink(g, CLERMONT_FERRAND, NANTES, ROAD);
-    addLink(g, CLERMONT_FERRAND, PARIS, ROAD);
-    addLink(g, CLERMONT_FERRAND, TOULOUSE, ROAD);
-    addLink(g, COLOGNE, FRANKFURT, ROAD);
-    addLink(g, COLOGNE, HAMBURG, ROAD);
-    addLink(g, COLOGNE, LEIPZIG, ROAD);
-    addLink(g, COLOGNE, STRASBOURG, ROAD);
-    addLink(g, CONSTANTA, GALATZ, ROAD);
-    addLink(g, CONSTANTA, VARNA, ROAD);
-    addLink(g, DUBLIN, GALWAY, ROAD);
-    addLink(g, EDINBURGH, MANCHESTER, ROAD);
-    addLink(g, FLORENCE, GENOA, ROAD);
-    addLink(g, FLORENCE, ROME, ROAD);
-    addLink(g, FLORENCE, VENICE, ROAD);
-    addLink(g, FRANKFURT, LEIPZIG, ROAD);
-    addLink(g, FRANKFURT, NUREMBURG, ROAD);
-    addLink(g, FRANKFURT, STRASBOURG, ROAD);
-    addLink(g, GALATZ, KLAUSENBURG, ROAD);
-    addLink(g, GENEVA, MARSEILLES, ROAD);
-    addLink(g, GENEVA, PARIS, ROAD);
-    addLink(g, GENEVA, STRASBOURG, ROAD);
-    addLink(g, GENEVA, ZURICH, ROAD);
-    addLink(g, GENOA, MARSEILLES, ROAD);
-    addLink(g, GENOA, MILAN, ROAD);
-    addLink(g, GENOA, VENICE, ROAD);
-    addLink(g, GRANADA, MADRID, ROAD);
-    addLink(g, HAMBURG, LEIPZIG, ROAD);
-    addLink(g, KLAUSENBURG, SZEGED, ROAD);
-    addLink(g, LEIPZIG, NUREMBURG, ROAD);
-    addLink(g, LE_HAVRE, NANTES, ROAD);
-    addLink(g, LE_HAVRE, PARIS, ROAD);
-    addLink(g, LISBON, MADRID, ROAD);
-    addLink(g, LISBON, SANTANDER, ROAD);
-    addLink(g, LIVERPOOL, MANCHESTER, ROAD);
-    addLink(g, LIVERPOOL, SWANSEA, ROAD);
-    addLink(g, LONDON, MANCHESTER, ROAD);
-    addLink(g, LONDON, PLYMOUTH, ROAD);
-    addLink(g, LONDON, SWANSEA, ROAD);
-    addLink(g, MADRID, SANTANDER, ROAD);
-    addLink(g, MADRID, SARAGOSSA, ROAD);
-    addLink(g, MARSEILLES, MILAN, ROAD);
-    addLink(g, MARSEILLES, TOULOUSE, ROAD);
-    addLink(g, MARSEILLES, ZURICH, ROAD);
-    addLink(g, MILAN, MUNICH, ROAD);
-    addLink(g, MILAN, VENICE, ROAD);
-    addLink(g, MILAN, ZURICH, ROAD);
-    addLink(g, MUNICH, NUREMBURG, ROAD);
-    addLink(g, MUNICH, STRASBOURG, ROAD);
-    addLink(g, MUNICH, VENICE, ROAD);
-    addLink(g, MUNICH, VIENNA, ROAD);
-    addLink(g, MUNICH, ZAGREB, ROAD);
-    addLink(g, MUNICH, ZURICH, ROAD);
-    addLink(g, NANTES, PARIS, ROAD);
-    addLink(g, NAPLES, ROME, ROAD);
-    addLink(g, NUREMBURG, PRAGUE, ROAD);
-    addLink(g, NUREMBURG, STRASBOURG, ROAD);
-    addLink(g, PARIS, STRASBOURG, ROAD);
-    addLink(g, PRAGUE, VIENNA, ROAD);
-    addLink(g, SALONICA, SOFIA, ROAD);
-    addLink(g, SALONICA, VALONA, ROAD);
-    addLink(g, SANTANDER, SARAGOSSA, ROAD);
-    addLink(g, SARAGOSSA, TOULOUSE, ROAD);
-    addLink(g, SARAJEVO, SOFIA, ROAD);
-    addLink(g, SARAJEVO, ST_JOSEPH_AND_ST_MARYS, ROAD);
-    addLink(g, SARAJEVO, VALONA, ROAD);
-    addLink(g, SARAJEVO, ZAGREB, ROAD);
-    addLink(g, SOFIA, VALONA, ROAD);
-    addLink(g, SOFIA, VARNA, ROAD);
-    addLink(g, STRASBOURG, ZURICH, ROAD);
-    addLink(g, ST_JOSEPH_AND_ST_MARYS, SZEGED, ROAD);
-    addLink(g, ST_JOSEPH_AND_ST_MARYS, ZAGREB, ROAD);
-    addLink(g, SZEGED, ZAGREB, ROAD);
-    addLink(g, VIENNA, ZAGREB, ROAD);
+// returns the fewest turns hunter needs to get FROM a TO b, starting in
+// round
+int  hunterTurns(LocationID a, LocationID b, PlayerID hunter, Round round)
+{
+    assert(validPlace(a) && validPlace(b));
+    assert(0 <= hunter && hunter < PLAYER_DRACULA);
+    assert(round >= 0);
+    return getMap()->hunterTurns[(round + hunter) % NUM_RAIL_HOPS][a][b];
+}
+
+// returns hunter's first move on the way FROM a TO b, starting in round
+LocationID hunterNextHop(LocationID a, LocationID b, PlayerID hunter,
+                         Round round)
+{
+    assert(validPlace(a) && validPlace(b));
+    assert(0 <= hunter && hunter < PLAYER_DRACULA);
+    assert(round >= 0);
+    return getMap()->hunterNext[(round + hunter) % NUM_RAIL_HOPS][a][b];
+}
+
+// returns the fewest turns Dracula needs to get FROM a TO b
+int  draculaTurns(LocationID a, LocationID b)
+{
+    assert(validPlace(a) && validPlace(b));
+    return getMap()->draculaTurns[a][b];
+}
+
+// returns the least blood Dracula loses getting FROM a TO b
+int  draculaBlood(LocationID a, LocationID b)
+{
+    assert(validPlace(a) && validPlace(b));
+    assert(a != ST_JOSEPH_AND_ST_MARYS && b != ST_JOSEPH_AND_ST_MARYS);
+    return getMap()->draculaBlood[a][b];
+}
+
+// returns Dracula's best ways FROM a TO b for each number of turns
+const DracCost *draculaCosts(LocationID a, LocationID b, int *numCosts)
+{
+    Map g = getMap();
+    assert(validPlace(a) && validPlace(b));
+    assert(a != ST_JOSEPH_AND_ST_MARYS && b != ST_JOSEPH_AND_ST_MARYS);
+    assert(numCosts != NULL);
+    int i = a * NUM_MAP_LOCATIONS + b;
+    (*numCosts) = g->costStart[i+1] - g->costStart[i];
+    return &g->dracCosts[g->costStart[i]];
+}
+
+// returns the locations one edge of transport t away from v
+const LocationID *neighbours(Map g, TransportID t, LocationID v,
+                             int *numNeighbours)
+{
+    assert(g != NULL);
+    assert(t >= 0 && t <= ANY);
+    assert(validPlace(v));
+    assert(numNeighbours != NULL);
+    (*numNeighbours) = g->first[t][v+1] - g->first[t][v];
+    return &g->arcs[t][g->first[t][v]];
+}
 
-    //### RAIL Connections ###
+// returns the locations one edge of transport t away from v, as a set
+LocationSet adjacentSet(Map g, TransportID t, LocationID v)
+{
+    assert(g != NULL);
+    assert(t >= 0 && t <= ANY);
+    assert(validPlace(v));
+    return g->adj[t][v];
+}
 
-    addLink(g, ALICANTE, BARCELONA, RAIL);
-    addLink(g, ALICANTE, MADRID, RAIL);
-    addLink(g, BARCELONA, SARAGOSSA, RAIL);
-    addLink(g, BARI, NAPLES, RAIL);
-    addLink(g, BELGRADE, SOFIA, RAIL);
-    addLink(g, BELGRADE, SZEGED, RAIL);
-    addLink(g, BERLIN, HAMBURG, RAIL);
-    addLink(g, BERLIN, LEIPZIG, RAIL);
-    addLink(g, BERLIN, PRAGUE, RAIL);
-    addLink(g, BORDEAUX, PARIS, RAIL);
-    addLink(g, BORDEAUX, SARAGOSSA, RAIL);
-    addLink(g, BRUSSELS, COLOGNE, RAIL);
-    addLink(g, BRUSSELS, PARIS, RAIL);
-    addLink(g, BUCHAREST, CONSTANTA, RAIL);
-    addLink(g, BUCHAREST, GALATZ, RAIL);
-    addLink(g, BUCHAREST, SZEGED, RAIL);
-    addLink(g, BUDAPEST, SZEGED, RAIL);
-    addLink(g, BUDAPEST, VIENNA, RAIL);
-    addLink(g, COLOGNE, FRANKFURT, RAIL);
-    addLink(g, EDINBURGH, MANCHESTER, RAIL);
-    addLink(g, FLORENCE, MILAN, RAIL);
-    addLink(g, FLORENCE, ROME, RAIL);
-    addLink(g, FRANKFURT, LEIPZIG, RAIL);
-    addLink(g, FRANKFURT, STRASBOURG, RAIL);
-    addLink(g, GENEVA, MILAN, RAIL);
-    addLink(g, GENOA, MILAN, RAIL);
-    addLink(g, LEIPZIG, NUREMBURG, RAIL);
-    addLink(g, LE_HAVRE, PARIS, RAIL);
-    addLink(g, LISBON, MADRID, RAIL);
-    addLink(g, LIVERPOOL, MANCHESTER, RAIL);
-    addLink(g, LONDON, MANCHESTER, RAIL);
-    addLink(g, LONDON, SWANSEA, RAIL);
-    addLink(g, MADRID, SANTANDER, RAIL);
-    addLink(g, MADRID, SARAGOSSA, RAIL);
-    addLink(g, MARSEILLES, PARIS, RAIL);
-    addLink(g, MILAN, ZURICH, RAIL);
-    addLink(g, MUNICH, NUREMBURG, RAIL);
-    addLink(g, NAPLES, ROME, RAIL);
-    addLink(g, PRAGUE, VIENNA, RAIL);
-    addLink(g, SALONICA, SOFIA, RAIL);
-    addLink(g, SOFIA, VARNA, RAIL);
-    addLink(g, STRASBOURG, ZURICH, RAIL);
-    addLink(g, VENICE, VIENNA, RAIL);
+// returns every sea location
+LocationSet seaSet(Map g)
+{
+    assert(g != NULL);
+    return g->seas;
+}
 
-    //### BOAT Connections ###
+// returns every location a hunter at v can reach in one turn
+LocationSet hunterMoveSet(Map g, LocationID v, int railHops, int flags)
+{
+    assert(g != NULL);
+    assert(validPlace(v));
+    assert(0 <= railHops && railHops < NUM_RAIL_HOPS);
+    assert(0 <= flags && flags < NUM_MOVE_FLAGS);
+    return g->hunterMoves[v][railHops][flags];
+}
 
-    addLink(g, ADRIATIC_SEA, BARI, BOAT);
-    addLink(g, ADRIATIC_SEA, IONIAN_SEA, BOAT);
-    addLink(g, ADRIATIC_SEA, VENICE, BOAT);
-    addLink(g, ALICANTE, MEDITERRANEAN_SEA, BOAT);
-    addLink(g, AMSTERDAM, NORTH_SEA, BOAT);
-    addLink(g, ATHENS, IONIAN_SEA, BOAT);
-    addLink(g, ATLANTIC_OCEAN, BAY_OF_BISCAY, BOAT);
-    addLink(g, ATLANTIC_OCEAN, CADIZ, BOAT);
-    addLink(g, ATLANTIC_OCEAN, ENGLISH_CHANNEL, BOAT);
-    addLink(g, ATLANTIC_OCEAN, GALWAY, BOAT);
-    addLink(g, ATLANTIC_OCEAN, IRISH_SEA, BOAT);
-    addLink(g, ATLANTIC_OCEAN, LISBON, BOAT);
-    addLink(g, ATLANTIC_OCEAN, MEDITERRANEAN_SEA, BOAT);
-    addLink(g, ATLANTIC_OCEAN, NORTH_SEA, BOAT);
-    addLink(g, BARCELONA, MEDITERRANEAN_SEA, BOAT);
-    addLink(g, BAY_OF_BISCAY, BORDEAUX, BOAT);
-    addLink(g, BAY_OF_BISCAY, NANTES, BOAT);
-    addLink(g, BAY_OF_BISCAY, SANTANDER, BOAT);
-    addLink(g, BLACK_SEA, CONSTANTA, BOAT);
-    addLink(g, BLACK_SEA, IONIAN_SEA, BOAT);
-    addLink(g, BLACK_SEA, VARNA, BOAT);
-    addLink(g, CAGLIARI, MEDITERRANEAN_SEA, BOAT);
-    addLink(g, CAGLIARI, TYRRHENIAN_SEA, BOAT);
-    addLink(g, DUBLIN, IRISH_SEA, BOAT);
-    addLink(g, EDINBURGH, NORTH_SEA, BOAT);
-    addLink(g, ENGLISH_CHANNEL, LE_HAVRE, BOAT);
-    addLink(g, ENGLISH_CHANNEL, LONDON, BOAT);
-    addLink(g, ENGLISH_CHANNEL, NORTH_SEA, BOAT);
-    addLink(g, ENGLISH_CHANNEL, PLYMOUTH, BOAT);
-    addLink(g, GENOA, TYRRHENIAN_SEA, BOAT);
-    addLink(g, HAMBURG, NORTH_SEA, BOAT);
-    addLink(g, IONIAN_SEA, SALONICA, BOAT);
-    addLink(g, IONIAN_SEA, TYRRHENIAN_SEA, BOAT);
-    addLink(g, IONIAN_SEA, VALONA, BOAT);
-    addLink(g, IRISH_SEA, LIVERPOOL, BOAT);
-    addLink(g, IRISH_SEA, SWANSEA, BOAT);
-    addLink(g, MARSEILLES, MEDITERRANEAN_SEA, BOAT);
-    addLink(g, MEDITERRANEAN_SEA, TYRRHENIAN_SEA, BOAT);
-    addLink(g, NAPLES, TYRRHENIAN_SEA, BOAT);
-    addLink(g, ROME, TYRRHENIAN_SEA, BOAT);
+// the same, as a list
+const LocationID *hunterMoveList(Map g, LocationID v, int railHops, int flags,
+                                 int *numMoves)
+{
+    assert(numMoves != NULL);
+    (*numMoves) = setSize(hunterMoveSet(g, v, railHops, flags));
+    return &g->moveArcs[g->hunterStart[v][railHops][flags]];
+}
+
+// returns every location Dracula at v can reach in one turn
+LocationSet draculaMoveSet(Map g, LocationID v, int flags)
+{
+    assert(g != NULL);
+    assert(validPlace(v));
+    assert(0 <= flags && flags < NUM_MOVE_FLAGS);
+    return g->draculaMoves[v][flags];
+}
+
+// the same, as a list
+const LocationID *draculaMoveList(Map g, LocationID v, int flags,
+                                  int *numMoves)
+{
+    assert(numMoves != NULL);
+    (*numMoves) = setSize(draculaMoveSet(g, v, flags));
+    return &g->moveArcs[g->draculaStart[v][flags]];
 }
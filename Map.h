@@ -3,21 +3,48 @@
 #ifndef MAP_H
 #define MAP_H
 
+#include "Globals.h"
 #include "Places.h"
+#include "LocationSet.h"
 
 #define NO_EDGE -1
+#define NO_PATH -1
 #define NUM_TRANSPORT (ANY+1)
 
+// which kinds of move a player may make in a turn, for the move tables
+// (rail is given separately, as the number of rail hops allowed)
+#define MOVE_ROAD 1
+#define MOVE_SEA  2
+#define NUM_MOVE_FLAGS 4
+
+// hunters may take 0..3 rail hops in one turn
+#define NUM_RAIL_HOPS 4
+
 typedef struct edge{
     LocationID  start;
     LocationID  end;
     TransportID type;
 } Edge;
 
+// a way for Dracula to get somewhere: how many turns it takes, and how
+// much blood he loses on the way (less than none if he gains some)
+typedef struct dracCost {
+    signed char turns;
+    signed char blood;
+} DracCost;
+
 // graph representation is hidden 
-typedef struct MapRep *Map; 
+// (and read-only: the map never changes once the program is built)
+typedef const struct MapRep *Map; 
+
+// there is exactly one map per process; its tables are generated at build
+// time into read-only data, so it costs nothing to start and can be shared
+// freely between threads
+Map  getMap(void);
 
 // operations on graphs 
+// newMap() hands back the shared map and disposeMap() leaves it alone;
+// they are kept so older callers don't need changing
 Map  newMap();  
 void disposeMap(Map g); 
 void showMap(Map g); 
@@ -28,4 +55,72 @@ int  numE(Map g, TransportID t);
 // or NO_EDGE if no such edge exists
 int  getDist(Map g, TransportID t, int a, int b);
 
+// returns the fewest edges of transport t needed to get FROM a TO b
+// (ANY lets the path mix transports), or NO_PATH if there is no such path
+// the table behind this is generated at build time
+int  getHops(TransportID t, LocationID a, LocationID b);
+
+// returns the fewest turns the given hunter needs to get FROM a TO b, if
+// their first turn is in round; unlike getHops() this counts only the
+// rail hops they're allowed each turn ((round + hunter) % 4 of them)
+// the table behind this, and the one below, is generated at build time
+int  hunterTurns(LocationID a, LocationID b, PlayerID hunter, Round round);
+
+// returns where the given hunter at a should move in round to get TO b
+// in hunterTurns() turns (the lowest numbered such move), or b if a is b
+LocationID hunterNextHop(LocationID a, LocationID b, PlayerID hunter,
+                         Round round);
+
+// returns the locations joined to v by a direct edge of transport t
+// (ANY gives the union over all transports); v itself is not included
+// the array belongs to the map and must not be freed or changed
+const LocationID *neighbours(Map g, TransportID t, LocationID v,
+                             int *numNeighbours);
+
+// the same locations as neighbours(), as a set
+LocationSet adjacentSet(Map g, TransportID t, LocationID v);
+
+// returns the set of every sea location (everything else is land)
+LocationSet seaSet(Map g);
+
+// returns every location a hunter at v can reach in one turn, allowed
+// railHops (0..3) rail edges and road and/or sea as given by flags
+// (MOVE_ROAD | MOVE_SEA); v itself is always included
+// these, and the three below, are table lookups generated at build time
+LocationSet hunterMoveSet(Map g, LocationID v, int railHops, int flags);
+
+// the same locations as hunterMoveSet(), as a list in id order
+// the array belongs to the map and must not be freed or changed
+const LocationID *hunterMoveList(Map g, LocationID v, int railHops, int flags,
+                                 int *numMoves);
+
+// returns every location Dracula at v can reach in one turn by road and/or
+// sea as given by flags; includes v, never includes the hospital, and takes
+// no notice of his trail
+LocationSet draculaMoveSet(Map g, LocationID v, int flags);
+
+// the same locations as draculaMoveSet(), as a list in id order
+const LocationID *draculaMoveList(Map g, LocationID v, int flags,
+                                  int *numMoves);
+
+// returns the fewest turns Dracula needs to get FROM a TO b by road and
+// sea, or NO_PATH if either is the hospital; no notice is taken of his
+// trail, here or below
+int  draculaTurns(LocationID a, LocationID b);
+
+// returns the least blood Dracula can lose getting FROM a TO b, in any
+// number of turns: LIFE_LOSS_SEA for every turn he ends at sea, less
+// LIFE_GAIN_CASTLE_DRACULA if he ends one at the castle (only counted
+// once, as his trail keeps him from coming back for long), so it's less
+// than none if he can go by the castle on the way
+// neither a nor b may be the hospital
+int  draculaBlood(LocationID a, LocationID b);
+
+// returns every way for Dracula to get FROM a TO b that loses less blood
+// than any quicker one, quickest first: the first is draculaTurns() turns
+// and the last loses draculaBlood()
+// neither a nor b may be the hospital
+// the array belongs to the map and must not be freed or changed
+const DracCost *draculaCosts(LocationID a, LocationID b, int *numCosts);
+
 #endif
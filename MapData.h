@@ -0,0 +1,93 @@
+// MapData.h ... layout of the precomputed map tables
+// The tables themselves are in MapData.c, which mkmap generates at build
+// time from the connection list; only Map.c, PlayDecoder.c and mkmap.c
+// should need this
+
+#ifndef MAP_DATA_H
+#define MAP_DATA_H
+
+#include "Map.h"
+#include "LocationSet.h"
+
+// upper bound on directed edges of any one transport (ANY included)
+#define MAX_ARCS 1024
+
+// total length of all the precomputed move lists
+#define MAX_MOVE_ARCS 8192
+
+// total length of all of Dracula's lists of costs
+#define MAX_DRAC_COSTS 16384
+
+struct MapRep {
+    int nV;                  // #vertices
+    int nE;                  // #distinct (start,end,type) edges
+
+    // adj[t][v] is the set of locations one edge of type t away from v
+    LocationSet adj[NUM_TRANSPORT][NUM_MAP_LOCATIONS];
+
+    // the same thing in CSR form: the neighbours of v by transport t are
+    // arcs[t][first[t][v]] .. arcs[t][first[t][v+1]-1], in id order
+    short      first[NUM_TRANSPORT][NUM_MAP_LOCATIONS+1];
+    LocationID arcs[NUM_TRANSPORT][MAX_ARCS];
+
+    // all-pairs fewest edges of each transport, or NO_PATH
+    signed char hops[NUM_TRANSPORT][NUM_MAP_LOCATIONS][NUM_MAP_LOCATIONS];
+
+    // every possible one-turn move, keyed by where the player starts, how
+    // many rail hops they get and which of MOVE_ROAD | MOVE_SEA they use;
+    // Dracula's table has no rail and never includes the hospital
+    LocationSet hunterMoves[NUM_MAP_LOCATIONS][NUM_RAIL_HOPS][NUM_MOVE_FLAGS];
+    LocationSet draculaMoves[NUM_MAP_LOCATIONS][NUM_MOVE_FLAGS];
+
+    // the same sets as lists in id order: each starts at moveArcs[xStart]
+    // and is as long as the matching set
+    short hunterStart[NUM_MAP_LOCATIONS][NUM_RAIL_HOPS][NUM_MOVE_FLAGS];
+    short draculaStart[NUM_MAP_LOCATIONS][NUM_MOVE_FLAGS];
+    LocationID moveArcs[MAX_MOVE_ARCS];
+
+    // every location that's a sea
+    LocationSet seas;
+
+    // the fewest turns a hunter needs to get from v to w, keyed by how
+    // many rail hops their first turn allows (each turn after allows one
+    // more, wrapping round to none), and the lowest numbered move that
+    // gets them there that soon (w itself if they're there already)
+    signed char hunterTurns[NUM_RAIL_HOPS]
+                           [NUM_MAP_LOCATIONS][NUM_MAP_LOCATIONS];
+    signed char hunterNext[NUM_RAIL_HOPS]
+                          [NUM_MAP_LOCATIONS][NUM_MAP_LOCATIONS];
+
+    // the same for Dracula, by his draculaMoves (no rail, no hospital):
+    // the fewest turns from v to w (NO_PATH if either is the hospital),
+    // and the least blood he loses on the way (0 if either is)
+    signed char draculaTurns[NUM_MAP_LOCATIONS][NUM_MAP_LOCATIONS];
+    signed char draculaBlood[NUM_MAP_LOCATIONS][NUM_MAP_LOCATIONS];
+
+    // his costs from v to w that beat any quicker ones: with i being
+    // v * NUM_MAP_LOCATIONS + w, they're dracCosts[costStart[i]] ..
+    // dracCosts[costStart[i+1]-1], in order of turns
+    short costStart[NUM_MAP_LOCATIONS * NUM_MAP_LOCATIONS + 1];
+    DracCost dracCosts[MAX_DRAC_COSTS];
+};
+
+// the one and only map
+extern const struct MapRep mapData;
+
+// a play's two abbreviation characters, as a 16-bit key (first char in
+// the low byte), hash to slot (key * mult) >> (32 - ABBREV_HASH_BITS);
+// mkmap picks mult so that no two abbreviations share a slot
+#define ABBREV_HASH_BITS 9
+#define ABBREV_HASH_SIZE (1 << ABBREV_HASH_BITS)
+
+struct AbbrevHash {
+    uint32_t mult;
+
+    // the key that lives in each slot (0 if none) and the move it means
+    uint16_t keys[ABBREV_HASH_SIZE];
+    signed char moves[ABBREV_HASH_SIZE];
+};
+
+// every location abbreviation, plus C?, S?, HI, D1-D5 and TP
+extern const struct AbbrevHash abbrevHash;
+
+#endif
@@ -16,7 +16,7 @@ typedef struct Place {
 // Each entry should satisfy (places[i].id == i)
 // First real place must be at index MIN_MAP_LOCATION
 // Last real place must be at index MAX_MAP_LOCATION
-static Place places[] =
+static const Place places[] =
 {
    {"Adriatic Sea", "AS", ADRIATIC_SEA, SEA},
    {"Alicante", "AL", ALICANTE, LAND},
@@ -127,9 +127,9 @@ int nameToID(char *name)
 int abbrevToID(char *abbrev)
 {
    // an attempt to optimise a linear search
-   Place *p;
-   Place *first = &places[MIN_MAP_LOCATION];
-   Place *last = &places[MAX_MAP_LOCATION];
+   const Place *p;
+   const Place *first = &places[MIN_MAP_LOCATION];
+   const Place *last = &places[MAX_MAP_LOCATION];
    for (p = first; p <= last; p++) {
       char *c = p->abbrev;
       if (c[0] == abbrev[0] && c[1] == abbrev[1] && c[2] == '\0') return p->id;
@@ -139,9 +139,9 @@ int abbrevToID(char *abbrev)
 
 
 char *IDToAbbrev(int ID) {
-   Place *p;
-   Place *first = &places[MIN_MAP_LOCATION];
-   Place *last = &places[MAX_MAP_LOCATION];
+   const Place *p;
+   const Place *first = &places[MIN_MAP_LOCATION];
+   const Place *last = &places[MAX_MAP_LOCATION];
    for (p = first; p <= last; p++) {
       if (ID == p->id) { 
          return p->abbrev;
@@ -0,0 +1,191 @@
+// PlayDecoder.c ... decoding plays a 64-bit word at a time
+// Byte i of a play ends up in bits 8i..8i+7 of its word, whatever the
+// machine's byte order, and the tests on the encounter chars are done on
+// all of them at once (SWAR: SIMD within a register)
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include "Globals.h"
+#include "Places.h"
+#include "MapData.h"
+#include "PlayDecoder.h"
+
+// bytes in one play, separator included
+#define PLAY_BLOCK_SIZE 8
+
+// which byte of the block holds what
+#define PLAYER_BYTE 0
+#define ABBREV_BYTE 1
+#define SEPARATOR_BYTE 7
+
+// the given char in every byte of a word
+#define BYTES(c) (0x0101010101010101ULL * (unsigned char)(c))
+
+// the low 7 bits of every byte
+#define LOW_BITS BYTES(0x7F)
+
+// the top bit of byte i
+#define TOP_BIT(i) (0x80ULL << (8 * (i)))
+
+// the top bits of a hunter's four encounter bytes
+#define HUNTER_ENCOUNTERS \
+    (TOP_BIT(3) | TOP_BIT(4) | TOP_BIT(5) | TOP_BIT(6))
+
+// where Dracula's play says what he left and what fell off his trail
+#define DRACULA_TRAP_BIT TOP_BIT(3)
+#define DRACULA_VAMP_BIT TOP_BIT(4)
+#define DRACULA_ACTION_BIT TOP_BIT(5)
+
+static uint64_t loadBlock(const char *play);
+static uint64_t matchBytes(uint64_t word, char c);
+static LocationID lookupMove(uint16_t key);
+static PlayerID playerOf(char c);
+static void decodeWord(uint64_t word, PlayRecord *record);
+
+// What move does a two char abbreviation stand for
+LocationID decodeMove(const char *abbrev)
+{
+    assert(abbrev != NULL);
+    return lookupMove((uint16_t)((unsigned char)abbrev[0] |
+                                 ((unsigned char)abbrev[1] << 8)));
+}
+
+// The abbreviation for a move
+const char *encodeMove(LocationID move)
+{
+    // the moves that aren't places, from CITY_UNKNOWN up
+    static const char *others[] = {
+        "C?", "S?", "HI", "D1", "D2", "D3", "D4", "D5", "TP"
+    };
+
+    const char *abbrev = NULL;
+    if(validPlace(move)) {
+        abbrev = IDToAbbrev(move);
+    } else if(CITY_UNKNOWN <= move && move <= TELEPORT) {
+        abbrev = others[move - CITY_UNKNOWN];
+    }
+    return abbrev;
+}
+
+// Decode a single play
+void decodePlay(const char *play, PlayRecord *record)
+{
+    assert(play != NULL);
+    assert(record != NULL);
+    decodeWord(loadBlock(play), record);
+}
+
+// Decode every play in a pastPlays string
+int decodePlays(const char *pastPlays, PlayRecord records[], int maxPlays)
+{
+    assert(pastPlays != NULL);
+    assert(records != NULL);
+
+    int n = 0;
+
+    // the last play is followed by the NUL rather than a separator, so
+    // every block we load is all there
+    if(pastPlays[0] != '\0') {
+        const char *play = pastPlays;
+        int more = TRUE;
+        while(more == TRUE && n < maxPlays) {
+            uint64_t word = loadBlock(play);
+            decodeWord(word, &records[n]);
+            n++;
+
+            more = ((word >> (8 * SEPARATOR_BYTE)) != 0);
+            play += PLAY_BLOCK_SIZE;
+        }
+    }
+
+    return n;
+}
+
+// Read a play block as one word, first char in the low byte
+static uint64_t loadBlock(const char *play)
+{
+    uint64_t word;
+    memcpy(&word, play, sizeof(word));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+// The top bit set in each byte of word that is c, and nothing else
+// (no carries between bytes, so there are no false matches)
+static uint64_t matchBytes(uint64_t word, char c)
+{
+    uint64_t x = word ^ BYTES(c);
+    uint64_t t = (x & LOW_BITS) + LOW_BITS;
+    return ~(t | x | LOW_BITS);
+}
+
+// Look up an abbreviation's key in the generated perfect hash
+static LocationID lookupMove(uint16_t key)
+{
+    uint32_t slot = (key * abbrevHash.mult) >> (32 - ABBREV_HASH_BITS);
+
+    LocationID move = NOWHERE;
+    if(abbrevHash.keys[slot] == key) {
+        move = abbrevHash.moves[slot];
+    }
+    return move;
+}
+
+// Which player a play's first char stands for
+static PlayerID playerOf(char c)
+{
+    PlayerID player;
+    switch(c) {
+        case 'G': player = PLAYER_LORD_GODALMING; break;
+        case 'S': player = PLAYER_DR_SEWARD; break;
+        case 'H': player = PLAYER_VAN_HELSING; break;
+        case 'M': player = PLAYER_MINA_HARKER; break;
+        case 'D': player = PLAYER_DRACULA; break;
+        default:
+            assert (FALSE && "This is not a valid identifier for a player.");
+            player = NOWHERE;
+    }
+    return player;
+}
+
+// Decode a play that's already been loaded into a word
+static void decodeWord(uint64_t word, PlayRecord *record)
+{
+    LocationID move =
+        lookupMove((uint16_t)(word >> (8 * ABBREV_BYTE)));
+
+    record->player = playerOf((char)(word >> (8 * PLAYER_BYTE)));
+    record->move = move;
+    record->location = validPlace(move) ? move : NOWHERE;
+
+    uint64_t traps = matchBytes(word, 'T');
+    uint64_t vamps = matchBytes(word, 'V');
+
+    int encounters = 0;
+    if(record->player == PLAYER_DRACULA) {
+        if(traps & DRACULA_TRAP_BIT) {
+            encounters |= ENCOUNTER_PLACED_TRAP;
+        }
+        if(vamps & DRACULA_VAMP_BIT) {
+            encounters |= ENCOUNTER_PLACED_VAMPIRE;
+        }
+        if(matchBytes(word, 'M') & DRACULA_ACTION_BIT) {
+            encounters |= ENCOUNTER_TRAP_EXPIRED;
+        } else if(vamps & DRACULA_ACTION_BIT) {
+            encounters |= ENCOUNTER_VAMPIRE_MATURED;
+        }
+    } else {
+        // there are never more than 3 traps in one place
+        encounters = __builtin_popcountll(traps & HUNTER_ENCOUNTERS);
+        if(vamps & HUNTER_ENCOUNTERS) {
+            encounters |= ENCOUNTER_VAMPIRE;
+        }
+        if(matchBytes(word, 'D') & HUNTER_ENCOUNTERS) {
+            encounters |= ENCOUNTER_DRACULA;
+        }
+    }
+    record->encounters = encounters;
+}
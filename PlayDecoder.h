@@ -0,0 +1,68 @@
+// PlayDecoder.h ... turns pastPlays text into decoded plays
+// Every play is a fixed 8-byte block (player, two-char location, four
+// encounter/action chars, separator), so the decoder reads each one as a
+// single 64-bit word and looks its abbreviation up in a generated perfect
+// hash instead of scanning the place names
+
+#ifndef PLAY_DECODER_H
+#define PLAY_DECODER_H
+
+#include "Globals.h"
+#include "Places.h"
+
+// What happened on one turn, already decoded from the play string
+// location and move are LocationIDs, which all fit in a signed char
+typedef struct playRecord {
+    signed char player;       // who made the play
+    signed char location;     // where it took them, as getTrailLocations()
+                              //   would work it out (hunters: where they
+                              //   moved, even if they ended up in hospital)
+    signed char move;         // the move as the play gives it: a place,
+                              //   CITY_UNKNOWN, HIDE, TELEPORT, ...
+    unsigned char encounters; // ENCOUNTER_ flags, below
+} PlayRecord;
+
+// encounters for a hunter's play
+// (the low bits count traps, since a hunter can fall into several)
+#define ENCOUNTER_TRAPS_MASK     0x03
+#define ENCOUNTER_VAMPIRE        0x04
+#define ENCOUNTER_DRACULA        0x08
+
+// not in the play itself: the GameView sets this when the hunter ended
+// the play in hospital, so location isn't where they really are
+#define ENCOUNTER_HOSPITAL       0x10
+
+// encounters for Dracula's play
+#define ENCOUNTER_PLACED_TRAP    0x10
+#define ENCOUNTER_PLACED_VAMPIRE 0x20
+#define ENCOUNTER_TRAP_EXPIRED   0x40
+#define ENCOUNTER_VAMPIRE_MATURED 0x80
+
+// decodeMove() gives the move a two character abbreviation stands for:
+//   a location in the interval [0...70], CITY_UNKNOWN, SEA_UNKNOWN, HIDE,
+//   DOUBLE_BACK_N or TELEPORT
+// Returns NOWHERE if it isn't any of those
+
+LocationID decodeMove(const char *abbrev);
+
+// encodeMove() gives the two character abbreviation for a move, the
+//   other way round from decodeMove(); NULL if it isn't a move
+// The string is shared and must not be changed
+
+const char *encodeMove(LocationID move);
+
+// decodePlay() decodes the single play starting at play
+// The player, move and encounters are filled in, with move straight from
+//   decodeMove(); location is the move if that is a real place, otherwise
+//   NOWHERE (following HIDE and DOUBLE_BACK_N needs the trail)
+// All 8 bytes of the block are read, so play must be followed by either
+//   a separator or the string's NUL
+
+void decodePlay(const char *play, PlayRecord *record);
+
+// decodePlays() decodes the plays in pastPlays into records, in order
+// At most maxPlays are decoded; returns how many were
+
+int decodePlays(const char *pastPlays, PlayRecord records[], int maxPlays);
+
+#endif
@@ -0,0 +1,172 @@
+// Playout.c ... playout policies and rewards
+
+#include <stdlib.h>
+#include <assert.h>
+#include "Globals.h"
+#include "Places.h"
+#include "Map.h"
+#include "GameState.h"
+#include "Random.h"
+#include "Playout.h"
+
+#define NUM_HUNTERS (NUM_PLAYERS - 1)
+
+// how often (out of 100) a hunter heads straight for Dracula
+#define CHASE_PERCENT 50
+
+// Dracula keeps out of places a hunter is this close to, if he can
+#define THREAT_HOPS 1
+
+static LocationID draculaPlayout(const GameState *s, RandomState *rng);
+static LocationID hunterPlayout(const GameState *s, RandomState *rng);
+
+// A move for whoever's turn it is
+LocationID playoutMove(const GameState *s, RandomState *rng)
+{
+    assert(s != NULL);
+    assert(rng != NULL);
+
+    LocationID move;
+    if(s->player == PLAYER_DRACULA) {
+        move = draculaPlayout(s, rng);
+    } else {
+        move = hunterPlayout(s, rng);
+    }
+    return move;
+}
+
+// Plays on for a few rounds
+int playOut(GameState *s, RandomState *rng, int rounds)
+{
+    assert(s != NULL);
+    assert(rng != NULL);
+
+    int numMoves = 0;
+    int endRound = s->round + rounds;
+    while(!isGameOver(s) && s->round < endRound) {
+        applyMove(s, playoutMove(s, rng));
+        numMoves++;
+    }
+    return numMoves;
+}
+
+// The hunter's move fewest turns from target, and the next fewest
+LocationID chaseMove(const GameState *s, PlayerID hunter, LocationID target,
+                     LocationID *nextBest)
+{
+    assert(s != NULL);
+
+    int numMoves;
+    const LocationID *moves = hunterMoves(s, hunter, &numMoves);
+
+    // counted from their turn after this one
+    Round round = s->round + (hunter < s->player) + 1;
+    LocationID best = s->location[hunter];
+    LocationID second = best;
+    int bestTurns = turnsBetween(best, target, hunter, round);
+    int secondTurns = NUM_MAP_LOCATIONS;
+    int i;
+    for(i = 0; i < numMoves; i++) {
+        int turns = turnsBetween(moves[i], target, hunter, round);
+        if(turns < bestTurns) {
+            second = best;
+            secondTurns = bestTurns;
+            best = moves[i];
+            bestTurns = turns;
+        } else if(turns < secondTurns && moves[i] != best) {
+            second = moves[i];
+            secondTurns = turns;
+        }
+    }
+
+    if(nextBest != NULL) {
+        (*nextBest) = second;
+    }
+    return best;
+}
+
+// How well Dracula has done
+double draculaReward(const GameState *s)
+{
+    assert(s != NULL);
+
+    double r;
+    if(s->health[PLAYER_DRACULA] <= 0) {
+        r = 0;
+    } else if(s->score <= 0) {
+        r = 1;
+    } else {
+        int blood = s->health[PLAYER_DRACULA];
+        if(blood > GAME_START_BLOOD_POINTS) {
+            blood = GAME_START_BLOOD_POINTS;
+        }
+        r = 0.5 + 0.5 * blood / GAME_START_BLOOD_POINTS;
+    }
+    return r;
+}
+
+// How many hops between a and b, any way at all
+int hopsBetween(LocationID a, LocationID b)
+{
+    int hops = NUM_MAP_LOCATIONS;
+    if(validPlace(a) && validPlace(b)) {
+        hops = getHops(ANY, a, b);
+        if(hops == NO_PATH) {
+            hops = NUM_MAP_LOCATIONS;
+        }
+    }
+    return hops;
+}
+
+// How many turns hunter needs between a and b, starting in round
+int turnsBetween(LocationID a, LocationID b, PlayerID hunter, Round round)
+{
+    int turns = NUM_MAP_LOCATIONS;
+    if(validPlace(a) && validPlace(b)) {
+        turns = hunterTurns(a, b, hunter, round);
+    }
+    return turns;
+}
+
+// Dracula: anywhere that keeps away from the hunters, if there is one
+static LocationID draculaPlayout(const GameState *s, RandomState *rng)
+{
+    LocationID moves[MAX_STATE_MOVES];
+    LocationID dests[MAX_STATE_MOVES];
+    int numMoves = draculaMoves(s, moves, dests);
+
+    // pick one of the safe ones, each as likely (reservoir sampling)
+    LocationID move = moves[randomBelow(rng, numMoves)];
+    int numSafe = 0;
+    int i;
+    for(i = 0; i < numMoves; i++) {
+        int safe = TRUE;
+        PlayerID h;
+        for(h = 0; h < NUM_HUNTERS && safe; h++) {
+            if(hopsBetween(s->location[h], dests[i]) <= THREAT_HOPS) {
+                safe = FALSE;
+            }
+        }
+        if(safe) {
+            numSafe++;
+            if(randomBelow(rng, numSafe) == 0) {
+                move = moves[i];
+            }
+        }
+    }
+    return move;
+}
+
+// A hunter: sometimes straight for Dracula, otherwise anywhere
+static LocationID hunterPlayout(const GameState *s, RandomState *rng)
+{
+    LocationID move;
+    if(randomBelow(rng, 100) < CHASE_PERCENT) {
+        move = chaseMove(s, s->player, s->location[PLAYER_DRACULA], NULL);
+    } else {
+        int numMoves;
+        const LocationID *moves = hunterMoves(s, s->player, &numMoves);
+        move = moves[randomBelow(rng, numMoves)];
+    }
+    return move;
+}
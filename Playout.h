@@ -0,0 +1,52 @@
+// Playout.h ... playing a game on quickly, for Monte Carlo search
+// Simple policies for both sides, and what a finished playout is worth,
+// shared by every search so they all judge positions the same way
+
+#ifndef PLAYOUT_H
+#define PLAYOUT_H
+
+#include "Globals.h"
+#include "Places.h"
+#include "GameState.h"
+#include "Random.h"
+
+// playoutMove() picks a move for whoever's turn it is in s:
+//   Dracula keeps out of places a hunter is next to if he can, and
+//   otherwise goes anywhere he can; a hunter heads straight for Dracula
+//   half the time, and otherwise goes anywhere they can
+
+LocationID playoutMove(const GameState *s, RandomState *rng);
+
+// playOut() plays on from s with playoutMove() for the given number of
+//   rounds, or until the game is over
+// Returns how many moves were played
+
+int playOut(GameState *s, RandomState *rng, int rounds);
+
+// chaseMove() gives the place the hunter can move to that leaves them
+//   fewest turns from target, rail and all, and (if nextBest isn't NULL)
+//   the next best in nextBest
+// Either is where the hunter is now if nothing else is closer
+
+LocationID chaseMove(const GameState *s, PlayerID hunter, LocationID target,
+                     LocationID *nextBest);
+
+// draculaReward() gives how well Dracula has done, in [0, 1]: nothing if
+//   he's dead, everything if the score has run out, and otherwise more
+//   the more blood he has left
+// The hunters' reward is one less this
+
+double draculaReward(const GameState *s);
+
+// hopsBetween() gives how many hops there are between a and b by any
+//   transport (NUM_MAP_LOCATIONS if either isn't on the map)
+
+int hopsBetween(LocationID a, LocationID b);
+
+// turnsBetween() gives how many turns the hunter needs to get from a to b
+//   if their first turn is in round (see hunterTurns() in Map.h), or
+//   NUM_MAP_LOCATIONS if either isn't on the map
+
+int turnsBetween(LocationID a, LocationID b, PlayerID hunter, Round round);
+
+#endif
@@ -0,0 +1,42 @@
+// Random.h ... a small, fast random number generator
+// Everything here is inline; the state is one word, so each player, thread
+// or search can keep its own and get the same numbers from the same seed
+// (rand() is shared and slow, and the same sequence isn't guaranteed)
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+typedef struct randomState {
+    uint64_t state;
+} RandomState;
+
+// start a generator off from the given seed
+static inline void seedRandom(RandomState *r, uint64_t seed)
+{
+    r->state = seed;
+}
+
+// the next 64 random bits (splitmix64)
+static inline uint64_t nextRandom(RandomState *r)
+{
+    uint64_t z = (r->state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// a random number in [0...n-1]; n must be positive
+static inline int randomBelow(RandomState *r, int n)
+{
+    return (int)(((nextRandom(r) >> 32) * (uint64_t)n) >> 32);
+}
+
+// a random number in [0, 1)
+static inline double randomUnit(RandomState *r)
+{
+    return (nextRandom(r) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+#endif
@@ -0,0 +1,248 @@
+// TrailEnum.c ... TrailEnum ADT implementation
+// A depth first search from the oldest place in the trail to the newest;
+// each move cuts down where the next place can be before we try any of
+// them, so dead ends are found as early as possible
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "Globals.h"
+#include "Places.h"
+#include "Map.h"
+#include "LocationSet.h"
+#include "DracBelief.h"
+#include "Random.h"
+#include "TrailEnum.h"
+
+// how Dracula can move; he never has rail
+#define DRACULA_MOVES (MOVE_ROAD | MOVE_SEA)
+
+// first and last double back
+#define DOUBLE_BACK_FIRST DOUBLE_BACK_1
+#define DOUBLE_BACK_LAST DOUBLE_BACK_5
+
+// how many trails we make room for first; it doubles from there
+#define FIRST_ROOM 64
+
+struct trailEnum {
+    // Dracula's moves and where each place might be, most recent first
+    LocationID moves[TRAIL_SIZE];
+    LocationSet domain[TRAIL_SIZE];
+
+    // how many places are in his trail so far
+    int numKnown;
+
+    // everything we found
+    long long numTrails;
+    LocationSet support[TRAIL_SIZE];
+
+    // the trails themselves; the search never finds the same one twice,
+    // so there's nothing to throw out. Past maxStored of them, it's a
+    // reservoir: an even chance of keeping any of them
+    int maxStored;
+    int numStored;
+    int room;
+    TrailHypothesis *stored;
+    RandomState rng;
+};
+
+// what the search needs as it goes
+typedef struct search {
+    TrailEnum e;
+    signed char loc[TRAIL_SIZE];
+} Search;
+
+static void search(Search *s, int slot);
+static LocationSet candidates(Search *s, int slot);
+static void found(Search *s);
+static void store(TrailEnum e, const signed char loc[TRAIL_SIZE]);
+
+// Goes through every trail that fits
+TrailEnum newTrailEnum(const LocationID moves[TRAIL_SIZE], DracBelief belief,
+                       int maxStored)
+{
+    assert(moves != NULL);
+    assert(belief != NULL);
+    assert(maxStored >= 0);
+
+    TrailEnum e = malloc(sizeof(struct trailEnum));
+    assert(e != NULL);
+
+    int i;
+    uint64_t seed = 0;
+    e->numKnown = 0;
+    for(i = 0; i < TRAIL_SIZE; i++) {
+        seed = seed * 131 + (uint64_t)(moves[i] + 1);
+        e->moves[i] = moves[i];
+        e->domain[i] = possibleLocations(belief, i);
+        e->support[i] = setEmpty();
+        if(moves[i] != NOWHERE) {
+            e->numKnown = i + 1;
+        }
+    }
+    e->numTrails = 0;
+
+    // the same plays always keep the same trails
+    e->maxStored = maxStored;
+    e->numStored = 0;
+    e->room = 0;
+    e->stored = NULL;
+    seedRandom(&e->rng, seed);
+
+    Search s;
+    s.e = e;
+    memset(s.loc, NOWHERE, sizeof(s.loc));
+    search(&s, e->numKnown - 1);
+
+    return e;
+}
+
+// Frees all memory allocated for toBeDeleted
+void disposeTrailEnum(TrailEnum toBeDeleted)
+{
+    assert(toBeDeleted != NULL);
+    free(toBeDeleted->stored);
+    free(toBeDeleted);
+}
+
+// How many trails fit
+long long numTrails(TrailEnum e)
+{
+    assert(e != NULL);
+    return e->numTrails;
+}
+
+// Everywhere that's turnsAgo back in some trail
+LocationSet trailSlotSupport(TrailEnum e, int turnsAgo)
+{
+    assert(e != NULL);
+    assert(0 <= turnsAgo && turnsAgo < TRAIL_SIZE);
+    return e->support[turnsAgo];
+}
+
+// All the trails, if we kept them
+const TrailHypothesis *storedTrails(TrailEnum e, int *numStored)
+{
+    assert(e != NULL);
+    assert(numStored != NULL);
+
+    const TrailHypothesis *ret = NULL;
+    (*numStored) = 0;
+    if(e->numTrails == e->numStored) {
+        (*numStored) = e->numStored;
+        ret = e->stored;
+    }
+    return ret;
+}
+
+// Picks n trails at random
+int sampleTrails(TrailEnum e, RandomState *rng, int n, TrailHypothesis out[])
+{
+    assert(e != NULL);
+    assert(rng != NULL);
+    assert(n >= 0);
+    assert(out != NULL);
+
+    // pick from what we kept; a partial shuffle, so no repeats
+    int ret = (n < e->numStored) ? n : e->numStored;
+
+    int i;
+    for(i = 0; i < ret; i++) {
+        int j = i + randomBelow(rng, e->numStored - i);
+        TrailHypothesis t = e->stored[j];
+        e->stored[j] = e->stored[i];
+        e->stored[i] = t;
+        out[i] = t;
+    }
+    return ret;
+}
+
+// Tries every place for slot that fits the places after it (older ones)
+// and carries on to the next newer slot
+static void search(Search *s, int slot)
+{
+    if(slot < 0) {
+        found(s);
+    } else {
+        LocationSet c = candidates(s, slot);
+        LocationID v;
+        for(v = setNext(c, 0); v != NOWHERE; v = setNext(c, v+1)) {
+            s->loc[slot] = v;
+            search(s, slot-1);
+        }
+        s->loc[slot] = NOWHERE;
+    }
+}
+
+// Where the place in slot can be, given the older places already chosen
+static LocationSet candidates(Search *s, int slot)
+{
+    TrailEnum e = s->e;
+    LocationID move = e->moves[slot];
+    LocationSet c = e->domain[slot];
+
+    // the oldest one we know of could have come from anywhere
+    if(slot + 1 < e->numKnown) {
+        LocationID from = s->loc[slot+1];
+        LocationSet reach = draculaMoveSet(getMap(), from, DRACULA_MOVES);
+
+        if(move == HIDE) {
+            c = setIntersect(c, setOf(from));
+        } else if(move == TELEPORT) {
+            c = setIntersect(c, setOf(CASTLE_DRACULA));
+        } else if(DOUBLE_BACK_FIRST <= move && move <= DOUBLE_BACK_LAST) {
+            int back = slot + (move - DOUBLE_BACK_FIRST) + 1;
+            c = setIntersect(c, reach);
+            if(back < e->numKnown) {
+                c = setIntersect(c, setOf(s->loc[back]));
+            }
+        } else {
+            // an ordinary move: next door, and not anywhere in the trail
+            // he had then (the oldest place was just dropping off)
+            c = setIntersect(c, reach);
+
+            int i;
+            for(i = slot + 1; i < slot + TRAIL_SIZE && i < e->numKnown; i++) {
+                setRemove(&c, s->loc[i]);
+            }
+        }
+    }
+    return c;
+}
+
+// Counts a trail that fits, and keeps it if we can
+static void found(Search *s)
+{
+    TrailEnum e = s->e;
+    int i;
+
+    e->numTrails++;
+    for(i = 0; i < e->numKnown; i++) {
+        setAdd(&e->support[i], s->loc[i]);
+    }
+    store(e, s->loc);
+}
+
+// Keeps a trail while there's room; past that, the k-th trail takes the
+// place of one we have with chance maxStored/k (reservoir sampling)
+static void store(TrailEnum e, const signed char loc[TRAIL_SIZE])
+{
+    long long slot = e->numStored;
+    if(slot == e->room && e->room < e->maxStored) {
+        e->room = (e->room == 0) ? FIRST_ROOM : 2 * e->room;
+        if(e->room > e->maxStored) {
+            e->room = e->maxStored;
+        }
+        e->stored = realloc(e->stored, e->room * sizeof(TrailHypothesis));
+        assert(e->stored != NULL);
+    }
+
+    if(slot >= e->maxStored) {
+        slot = (long long)(nextRandom(&e->rng) % (uint64_t)e->numTrails);
+    } else {
+        e->numStored++;
+    }
+    if(slot < e->maxStored) {
+        memcpy(e->stored[slot].loc, loc, sizeof(e->stored[0].loc));
+    }
+}
@@ -0,0 +1,63 @@
+// TrailEnum.h ... every trail Dracula could have left, given what's seen
+// DracBelief knows where he might have been on each turn on its own; this
+// goes through whole 6-place trails, so the places have to fit together
+// (HIDE where he was, DOUBLE_BACK_N to the right place, moves next door
+// and never back into his trail). That's what says where his traps and
+// vampire could be
+
+#ifndef TRAIL_ENUM_H
+#define TRAIL_ENUM_H
+
+#include "Globals.h"
+#include "Places.h"
+#include "LocationSet.h"
+#include "DracBelief.h"
+#include "Random.h"
+
+typedef struct trailEnum *TrailEnum;
+
+// one possible trail: where Dracula was on each of his last TRAIL_SIZE
+// turns, most recent first, NOWHERE before the start of the game
+typedef struct trailHypothesis {
+    signed char loc[TRAIL_SIZE];
+} TrailHypothesis;
+
+// newTrailEnum() goes through every trail that fits
+// moves are Dracula's last TRAIL_SIZE moves as the plays give them, most
+//   recent first (NOWHERE before the start of the game); belief has seen
+//   the same plays and narrows down where each place can be
+// Up to maxStored of the trails are kept (each one found only once, at
+//   TRAIL_SIZE bytes a trail); if there are more, it keeps maxStored of
+//   them picked at random, the same ones for the same plays
+
+TrailEnum newTrailEnum(const LocationID moves[TRAIL_SIZE], DracBelief belief,
+                       int maxStored);
+
+// disposeTrailEnum() frees all memory allocated for toBeDeleted
+
+void disposeTrailEnum(TrailEnum toBeDeleted);
+
+// numTrails() gives how many different trails fit
+
+long long numTrails(TrailEnum e);
+
+// trailSlotSupport() gives every place that's turnsAgo back in at least
+//   one of the trails, in the interval [0...TRAIL_SIZE-1] (0 is now)
+
+LocationSet trailSlotSupport(TrailEnum e, int turnsAgo);
+
+// storedTrails() gives all the trails, in no particular order, with
+//   their number in the variable pointed to by numStored
+// Returns NULL (and 0 of them) if there were more than maxStored of them
+// The array belongs to e
+
+const TrailHypothesis *storedTrails(TrailEnum e, int *numStored);
+
+// sampleTrails() picks n of the trails at random, each as likely as any
+//   other, and puts them in out[]; returns how many it picked (fewer than
+//   n if there aren't that many trails, and never more than maxStored)
+// Picks from the trails newTrailEnum() kept, so it never searches again
+
+int sampleTrails(TrailEnum e, RandomState *rng, int n, TrailHypothesis out[]);
+
+#endif
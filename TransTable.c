@@ -0,0 +1,172 @@
+// TransTable.c ... TransTable ADT implementation
+// Each entry is two words: the key, and the data. An empty entry's key
+// is EMPTY (a key that happens to be EMPTY is taken as the next one up).
+// A thread takes an empty entry by compare and swap on its key, so two
+// threads can't both take it, and a key never changes again until the
+// table's cleared; so whatever data's read from an entry with the right
+// key is that key's, and adding to it is a compare and swap on one word
+// A bucket is one cache line, and a key's bucket is its low bits. Entries
+// are taken in order, and never given back, so two threads adding the
+// same new key both come to the same first empty entry, and only one of
+// them takes it; the other finds the key there when its swap fails
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include "Globals.h"
+#include "TransTable.h"
+
+#define CACHE_LINE 64
+
+// the key of an entry no one's taken
+#define EMPTY 0
+
+typedef struct entry {
+    atomic_uint_least64_t key;
+    atomic_uint_least64_t data;
+} Entry;
+
+typedef struct bucket {
+    Entry entries[ENTRIES_PER_BUCKET];
+} Bucket;
+
+struct transTable {
+    Bucket *buckets;
+    uint64_t mask;                    // numBuckets - 1
+};
+
+static Entry *findEntry(TransTable t, uint64_t key, int claim);
+
+// Makes an empty table with room for at least numEntries entries
+TransTable newTransTable(long numEntries)
+{
+    assert(numEntries > 0);
+    assert(sizeof(Bucket) == CACHE_LINE);
+
+    uint64_t numBuckets = 1;
+    while(numBuckets * ENTRIES_PER_BUCKET < numEntries) {
+        numBuckets *= 2;
+    }
+
+    TransTable t = malloc(sizeof(struct transTable));
+    assert(t != NULL);
+    t->buckets = aligned_alloc(CACHE_LINE, numBuckets * sizeof(Bucket));
+    assert(t->buckets != NULL);
+    t->mask = numBuckets - 1;
+    clearTransTable(t);
+
+    return t;
+}
+
+// Frees all memory allocated for toBeDeleted
+void disposeTransTable(TransTable toBeDeleted)
+{
+    assert(toBeDeleted != NULL);
+    free(toBeDeleted->buckets);
+    free(toBeDeleted);
+}
+
+// Forgets everything in t
+void clearTransTable(TransTable t)
+{
+    assert(t != NULL);
+    memset(t->buckets, 0, (t->mask + 1) * sizeof(Bucket));
+}
+
+// Looks for key's entry in t
+int probeTable(TransTable t, uint64_t key, uint64_t *data, TableStats *stats)
+{
+    assert(t != NULL && data != NULL && stats != NULL);
+
+    int found = FALSE;
+    Entry *e = findEntry(t, key, FALSE);
+    if(e != NULL) {
+        *data = atomic_load_explicit(&e->data, memory_order_relaxed);
+        found = (*data != NO_DATA);
+    }
+
+    stats->probes++;
+    if(found) {
+        stats->hits++;
+    }
+    return found;
+}
+
+// Adds amount to key's entry in t
+int addTable(TransTable t, uint64_t key, uint64_t amount, uint64_t limit,
+             TableStats *stats)
+{
+    assert(t != NULL && stats != NULL);
+
+    Entry *e = findEntry(t, key, TRUE);
+    if(e != NULL) {
+        // if someone else adds first, old is set to what they left, and
+        // we try again from there
+        uint64_t old = atomic_load_explicit(&e->data, memory_order_relaxed);
+        while(old < limit &&
+              !atomic_compare_exchange_weak_explicit(&e->data, &old,
+                  old + amount, memory_order_relaxed,
+                  memory_order_relaxed)) {
+        }
+    } else {
+        stats->collisions++;
+    }
+    stats->stores++;
+    return e != NULL;
+}
+
+// Adds what more counted into total
+void addTableStats(TableStats *total, const TableStats *more)
+{
+    assert(total != NULL && more != NULL);
+    total->probes += more->probes;
+    total->hits += more->hits;
+    total->stores += more->stores;
+    total->collisions += more->collisions;
+}
+
+// Sets every count in stats to zero
+void clearTableStats(TableStats *stats)
+{
+    assert(stats != NULL);
+    stats->probes = 0;
+    stats->hits = 0;
+    stats->stores = 0;
+    stats->collisions = 0;
+}
+
+// The entry in t holding key, or NULL if there's none; if claim is TRUE
+// and there's none, the first empty entry in its bucket is taken for it
+// (NULL if there are none)
+static Entry *findEntry(TransTable t, uint64_t key, int claim)
+{
+    if(key == EMPTY) {
+        key++;
+    }
+
+    Bucket *b = &t->buckets[key & t->mask];
+    Entry *found = NULL;
+    int searching = TRUE;
+    int i;
+    for(i = 0; i < ENTRIES_PER_BUCKET && searching; i++) {
+        Entry *e = &b->entries[i];
+        uint64_t was = atomic_load_explicit(&e->key, memory_order_relaxed);
+        if(was == EMPTY && claim) {
+            // on failure was is set to whoever took it, maybe for key
+            atomic_compare_exchange_strong_explicit(&e->key, &was, key,
+                memory_order_relaxed, memory_order_relaxed);
+            if(was == EMPTY) {
+                was = key;
+            }
+        }
+        if(was == key) {
+            found = e;
+            searching = FALSE;
+        } else if(was == EMPTY) {
+            // keys are taken in order, so it's nowhere further on
+            searching = FALSE;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,73 @@
+// TransTable.h ... a transposition table every search thread can share
+// Maps a position's key (see GameState.h) to 64 bits of counts the
+// search adds to. It's a fixed number of buckets, each exactly one cache
+// line of ENTRIES_PER_BUCKET entries, so a probe costs one cache miss.
+// There are no locks: an entry's key is set once, by compare and swap,
+// and its counts only ever go up, by compare and swap on the one word, so
+// no thread's addition is ever lost or lands on some other key
+// Nothing is pushed out until the table's cleared: once a key's bucket is
+// full of other keys, what's added for it is dropped
+// Only the shared tree search uses one (see TreeMcts.h)
+
+#ifndef TRANS_TABLE_H
+#define TRANS_TABLE_H
+
+#include <stdint.h>
+
+// how many entries share a cache line
+#define ENTRIES_PER_BUCKET 4
+
+// data that means nothing's been added yet
+#define NO_DATA 0
+
+typedef struct transTable *TransTable;
+
+// How the table's been used, by one caller: each thread keeps its own, so
+// counting costs nothing, and they're added up at the end
+// collisions are additions dropped because the bucket was full
+typedef struct tableStats {
+    long long probes;
+    long long hits;
+    long long stores;
+    long long collisions;
+} TableStats;
+
+// newTransTable() makes an empty table with room for at least numEntries
+//   entries (a power of two number of buckets)
+
+TransTable newTransTable(long numEntries);
+
+// disposeTransTable() frees all memory allocated for toBeDeleted
+
+void disposeTransTable(TransTable toBeDeleted);
+
+// clearTransTable() forgets everything in t
+// No one may be using t while it's cleared
+
+void clearTransTable(TransTable t);
+
+// probeTable() looks for key's entry in t; if it's there, sets data and
+//   returns TRUE, otherwise returns FALSE
+// Counts the probe, and any hit, in stats
+
+int probeTable(TransTable t, uint64_t key, uint64_t *data, TableStats *stats);
+
+// addTable() adds amount to the data in key's entry in t, making the
+//   entry (with NO_DATA) if there isn't one, unless the data's already at
+//   least limit; returns FALSE if there was no room for key
+// The caller packs its counts into the data so that they never carry
+//   out of the top once it's at limit
+// Counts the store, and any collision, in stats
+
+int addTable(TransTable t, uint64_t key, uint64_t amount, uint64_t limit,
+             TableStats *stats);
+
+// addTableStats() adds what more counted into total
+
+void addTableStats(TableStats *total, const TableStats *more);
+
+// clearTableStats() sets every count in stats to zero
+
+void clearTableStats(TableStats *stats);
+
+#endif
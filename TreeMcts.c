@@ -0,0 +1,674 @@
+// TreeMcts.c ... TreeMcts ADT implementation
+// Playouts go just as in DracMcts.c. The differences are all in how the
+// tree is shared:
+// - visits, values and the hunters' statistics are atomic counters,
+//   added to without locks (values in fixed point, since there's no
+//   atomic add for floating point)
+// - a node's firstChild goes from NO_NODE to EXPANDING by compare and
+//   swap, so only one thread adds its children; anyone else who gets
+//   there meanwhile plays out from it as if it were a leaf
+// - the children's block is taken from the pool by an atomic add, filled
+//   in, and only then published (a release store of firstChild)
+// - a node's visits go up by VIRTUAL_LOSS on the way down, and back down
+//   by all but one on the way up
+// Between batches every thread has stopped, so the root can be read
+// without any care
+// A node is reached by Dracula's moves alone, so it stands for every
+// position the hunters' replies on the way can leave him in. Each
+// Dracula move from each of those positions also has statistics of its
+// own, kept in a transposition table the threads share, keyed by the
+// position (score and round included) and the move. When choosing a
+// child, a move that's been tried from the position the playout is
+// really in is judged on what it did from there, wherever in the tree
+// that was; otherwise on the child's own statistics. The same position
+// comes up again and again under a node, by the same replies or by
+// different ones that end up in the same places, and those playouts all
+// pool what they find. A playout's count and reward go into the table
+// together, by compare and swap on one word, so none are lost; if the
+// table runs out of room for a pair, that pair is judged on the node's
+// statistics alone
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include "Globals.h"
+#include "Game.h"
+#include "Places.h"
+#include "GameState.h"
+#include "Anytime.h"
+#include "Random.h"
+#include "Playout.h"
+#include "Workers.h"
+#include "TransTable.h"
+#include "TreeMcts.h"
+
+#define NUM_HUNTERS (NUM_PLAYERS - 1)
+
+// the kinds of move a hunter picks from in the tree, as in DracMcts.c
+#define NUM_ARMS 3
+#define ARM_REST 0
+#define ARM_CHASE 1
+#define ARM_FLANK 2
+#define NO_ARM NUM_ARMS
+
+#define MSECS_PER_SEC 1000.0
+
+#define ROOT 0
+
+// what firstChild holds if the node has no children: not yet, someone's
+// adding them right now, or there wasn't room
+#define NO_NODE -1
+#define EXPANDING -2
+#define NO_ROOM -3
+
+// how far down the tree a playout can go, in rounds
+#define MAX_TREE_DEPTH 64
+
+// how many rounds a playout goes on for once it leaves the tree
+#define ROLLOUT_ROUNDS 10
+
+// UCT's exploration constant, for rewards in [0, 1]
+#define EXPLORATION 0.7
+
+// how many visits a playout counts against each node on its way down
+#define VIRTUAL_LOSS 3
+
+// rewards are added up in units of 1/REWARD_UNITS
+#define REWARD_UNITS 65536
+
+// how often, in playouts, to look at the clock, and how many playouts
+// each thread runs between offers of the best move
+#define PLAYOUTS_PER_CHECK 256
+#define PLAYOUTS_PER_OFFER 4096
+
+// no limit on how many playouts a thread runs
+#define NO_LIMIT -1
+
+// how many (position, move) pairs the transposition table remembers
+#define TABLE_ENTRIES (1 << 20)
+
+// a table entry is the move's playouts from the position in the top
+// bits and their total reward, in REWARD_UNITS, in the rest; a playout's
+// reward is at most REWARD_UNITS, so the total can't carry into the
+// playouts before they've reached their most
+#define EDGE_VISIT_SHIFT 40
+#define MAX_EDGE_VISITS ((1 << (64 - EDGE_VISIT_SHIFT)) - 1)
+#define EDGE_TOTAL_MASK (((uint64_t)1 << EDGE_VISIT_SHIFT) - 1)
+
+// odd constants for mixing what the Zobrist key leaves out into it
+// (splitmix64's)
+#define MIX_STEP 0x9E3779B97F4A7C15ULL
+#define MIX_1 0xBF58476D1CE4E5B9ULL
+#define MIX_2 0x94D049BB133111EBULL
+
+typedef struct node {
+    // how many playouts came through here (or are on their way through),
+    // and Dracula's total reward
+    atomic_int visits;
+    atomic_llong value;
+
+    // how many of those playouts are still on their way
+    atomic_int pending;
+
+    // the children are numChildren nodes in a row, from firstChild once
+    // it's been published; move is Dracula's move that leads here
+    atomic_int firstChild;
+    unsigned char numChildren;
+    signed char move;
+
+    // each hunter's statistics for their reply to move
+    atomic_int hunterVisits[NUM_HUNTERS][NUM_ARMS];
+    atomic_llong hunterValue[NUM_HUNTERS][NUM_ARMS];
+} Node;
+
+// what each thread keeps to itself
+typedef struct searcher {
+    RandomState rng;
+
+    long long playouts;
+    long long positions;
+    TableStats table;
+
+    // how many playouts this thread has left, and how many of them to run
+    // in this batch
+    long long left;
+    int batch;
+} Searcher;
+
+struct treeMcts {
+    Node *nodes;
+    int maxNodes;
+    atomic_int numNodes;
+
+    Searcher *searchers;
+    Workers workers;
+    TransTable table;
+
+    uint64_t seed;
+
+    // the search in progress, for the threads
+    const GameState *root;
+    Anytime clock;
+};
+
+static void runBatch(int worker, void *data);
+static void newNode(Node *node, LocationID move);
+static int playout(TreeMcts m, Searcher *t, RandomState *rng);
+static uint64_t positionKey(const GameState *s);
+static uint64_t edgeKey(uint64_t position, LocationID move);
+static void addToEdge(TreeMcts m, Searcher *t, uint64_t key,
+                      long long reward);
+static int children(TreeMcts m, int n, const GameState *s);
+static int expand(TreeMcts m, int n, const GameState *s);
+static int selectChild(TreeMcts m, Searcher *t, int n, int first,
+                       uint64_t position);
+static int selectArm(Node *node, PlayerID hunter);
+static LocationID armMove(const GameState *s, PlayerID hunter, int arm);
+static int bestChild(TreeMcts m);
+static void report(TreeMcts m, Anytime clock, PlayerMessage message);
+
+// Makes a search on numThreads threads, with room for maxNodes nodes
+TreeMcts newTreeMcts(int maxNodes, int numThreads, uint64_t seed)
+{
+    assert(maxNodes > MAX_STATE_MOVES);
+    assert(numThreads > 0);
+
+    TreeMcts m = malloc(sizeof(struct treeMcts));
+    assert(m != NULL);
+    m->nodes = malloc(maxNodes * sizeof(Node));
+    assert(m->nodes != NULL);
+    m->maxNodes = maxNodes;
+    atomic_init(&m->numNodes, 0);
+    m->workers = newWorkers(numThreads);
+    m->searchers = malloc(numWorkers(m->workers) * sizeof(Searcher));
+    assert(m->searchers != NULL);
+    m->table = newTransTable(TABLE_ENTRIES);
+
+    int i;
+    for(i = 0; i < numWorkers(m->workers); i++) {
+        m->searchers[i].playouts = 0;
+        m->searchers[i].positions = 0;
+        clearTableStats(&m->searchers[i].table);
+    }
+    m->seed = seed;
+    m->root = NULL;
+    m->clock = NULL;
+
+    return m;
+}
+
+// Frees all memory allocated for toBeDeleted
+void disposeTreeMcts(TreeMcts toBeDeleted)
+{
+    assert(toBeDeleted != NULL);
+    disposeWorkers(toBeDeleted->workers);
+    disposeTransTable(toBeDeleted->table);
+    free(toBeDeleted->searchers);
+    free(toBeDeleted->nodes);
+    free(toBeDeleted);
+}
+
+// Searches from root until the time's up
+LocationID searchTreeMcts(TreeMcts m, const GameState *root, Anytime clock,
+                          long long maxPlayouts)
+{
+    assert(m != NULL);
+    assert(root != NULL && root->player == PLAYER_DRACULA);
+    assert(clock != NULL);
+
+    m->root = root;
+    m->clock = clock;
+    atomic_store(&m->numNodes, 1);
+    newNode(&m->nodes[ROOT], NOWHERE);
+    atomic_store(&m->nodes[ROOT].firstChild, expand(m, ROOT, root));
+    clearTransTable(m->table);
+
+    // each thread's random numbers start from the next of the seed's own,
+    // so they're well apart; the playouts are shared out as evenly as
+    // they go
+    int numThreads = numWorkers(m->workers);
+    RandomState seeds;
+    seedRandom(&seeds, m->seed);
+    int i;
+    for(i = 0; i < numThreads; i++) {
+        Searcher *t = &m->searchers[i];
+        seedRandom(&t->rng, nextRandom(&seeds));
+        t->playouts = 0;
+        t->positions = 0;
+        clearTableStats(&t->table);
+        t->left = NO_LIMIT;
+        if(maxPlayouts > 0) {
+            t->left = maxPlayouts / numThreads +
+                      (i < maxPlayouts % numThreads);
+        }
+    }
+
+    LocationID move = NOWHERE;
+    int more = TRUE;
+    while(more) {
+        more = FALSE;
+        for(i = 0; i < numThreads; i++) {
+            Searcher *t = &m->searchers[i];
+            t->batch = PLAYOUTS_PER_OFFER;
+            if(t->left != NO_LIMIT && t->left < t->batch) {
+                t->batch = t->left;
+            }
+            if(t->batch > 0) {
+                more = TRUE;
+            }
+        }
+
+        if(more) {
+            runWorkers(m->workers, runBatch, m);
+
+            int best = bestChild(m);
+            move = m->nodes[best].move;
+            PlayerMessage message;
+            report(m, clock, message);
+            offerMove(clock, move, 1, atomic_load(&m->nodes[best].visits),
+                      message);
+            more = !timeIsUp(clock);
+        }
+    }
+
+    PlayerMessage message;
+    report(m, clock, message);
+    restateMove(clock, message);
+
+    m->root = NULL;
+    m->clock = NULL;
+    return move;
+}
+
+// How many playouts the last search ran
+long long treeMctsPlayouts(TreeMcts m)
+{
+    assert(m != NULL);
+    long long playouts = 0;
+    int i;
+    for(i = 0; i < numWorkers(m->workers); i++) {
+        playouts += m->searchers[i].playouts;
+    }
+    return playouts;
+}
+
+// How many positions the last search went through
+long long treeMctsNodes(TreeMcts m)
+{
+    assert(m != NULL);
+    long long positions = 0;
+    int i;
+    for(i = 0; i < numWorkers(m->workers); i++) {
+        positions += m->searchers[i].positions;
+    }
+    return positions;
+}
+
+// How big the last search's tree was
+int treeMctsTreeSize(TreeMcts m)
+{
+    assert(m != NULL);
+    int size = atomic_load(&m->numNodes);
+    return (size < m->maxNodes) ? size : m->maxNodes;
+}
+
+// How the last search used its transposition table
+void treeMctsTableStats(TreeMcts m, TableStats *stats)
+{
+    assert(m != NULL && stats != NULL);
+    clearTableStats(stats);
+    int i;
+    for(i = 0; i < numWorkers(m->workers); i++) {
+        addTableStats(stats, &m->searchers[i].table);
+    }
+}
+
+// How many threads the search runs on
+int treeMctsThreads(TreeMcts m)
+{
+    assert(m != NULL);
+    return numWorkers(m->workers);
+}
+
+// One thread's share of a batch: its playouts, unless the time's up
+// It works on its own copy of its random numbers and counts, so the
+// threads don't keep writing to the same cache lines
+static void runBatch(int worker, void *data)
+{
+    TreeMcts m = data;
+    Searcher *t = &m->searchers[worker];
+    RandomState rng = t->rng;
+    long long positions = 0;
+
+    int i = 0;
+    while(i < t->batch) {
+        positions += playout(m, t, &rng);
+        i++;
+        if(i % PLAYOUTS_PER_CHECK == 0 && timeIsUp(m->clock)) {
+            t->batch = i;
+        }
+    }
+
+    t->rng = rng;
+    t->playouts += i;
+    t->positions += positions;
+    if(t->left != NO_LIMIT) {
+        t->left -= i;
+    }
+}
+
+// Sets up a node, reached by move, before anyone else can see it
+static void newNode(Node *node, LocationID move)
+{
+    atomic_init(&node->visits, 0);
+    atomic_init(&node->value, 0);
+    atomic_init(&node->pending, 0);
+    atomic_init(&node->firstChild, NO_NODE);
+    node->numChildren = 0;
+    node->move = move;
+
+    int h, a;
+    for(h = 0; h < NUM_HUNTERS; h++) {
+        for(a = 0; a < NUM_ARMS; a++) {
+            atomic_init(&node->hunterVisits[h][a], 0);
+            atomic_init(&node->hunterValue[h][a], 0);
+        }
+    }
+}
+
+// One playout: down the tree, on at random, and back up
+// Returns how many positions it went through
+static int playout(TreeMcts m, Searcher *t, RandomState *rng)
+{
+    GameState s = *m->root;
+    int positions = 0;
+
+    // the nodes we went through, the table's key for the position and
+    // move that got us to each, and the hunters' replies at each
+    int path[MAX_TREE_DEPTH + 1];
+    uint64_t edges[MAX_TREE_DEPTH + 1];
+    unsigned char arms[MAX_TREE_DEPTH + 1][NUM_HUNTERS];
+    int depth = 0;
+
+    int n = ROOT;
+    atomic_fetch_add_explicit(&m->nodes[n].visits, VIRTUAL_LOSS,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&m->nodes[n].pending, 1, memory_order_relaxed);
+    path[depth++] = n;
+    int descending = TRUE;
+    while(descending && !isGameOver(&s) && depth <= MAX_TREE_DEPTH) {
+        int first = children(m, n, &s);
+        if(first < 0) {
+            descending = FALSE;
+        } else {
+            uint64_t position = positionKey(&s);
+            n = selectChild(m, t, n, first, position);
+            atomic_fetch_add_explicit(&m->nodes[n].visits, VIRTUAL_LOSS,
+                                      memory_order_relaxed);
+            atomic_fetch_add_explicit(&m->nodes[n].pending, 1,
+                                      memory_order_relaxed);
+            edges[depth] = edgeKey(position, m->nodes[n].move);
+            applyMove(&s, m->nodes[n].move);
+            positions++;
+
+            PlayerID h;
+            for(h = 0; h < NUM_HUNTERS; h++) {
+                arms[depth][h] = NO_ARM;
+                if(!isGameOver(&s)) {
+                    int arm = selectArm(&m->nodes[n], h);
+                    applyMove(&s, armMove(&s, h, arm));
+                    positions++;
+                    arms[depth][h] = arm;
+                }
+            }
+            path[depth++] = n;
+        }
+    }
+
+    positions += playOut(&s, rng, ROLLOUT_ROUNDS);
+    long long reward = llround(draculaReward(&s) * REWARD_UNITS);
+    long long hunterReward = REWARD_UNITS - reward;
+
+    int i;
+    for(i = 0; i < depth; i++) {
+        Node *node = &m->nodes[path[i]];
+        atomic_fetch_sub_explicit(&node->visits, VIRTUAL_LOSS - 1,
+                                  memory_order_relaxed);
+        atomic_fetch_sub_explicit(&node->pending, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&node->value, reward,
+                                  memory_order_relaxed);
+        if(i > 0) {
+            addToEdge(m, t, edges[i], reward);
+        }
+
+        PlayerID h;
+        for(h = 0; h < NUM_HUNTERS && i > 0; h++) {
+            int arm = arms[i][h];
+            if(arm != NO_ARM) {
+                atomic_fetch_add_explicit(&node->hunterVisits[h][arm], 1,
+                                          memory_order_relaxed);
+                atomic_fetch_add_explicit(&node->hunterValue[h][arm],
+                                          hunterReward, memory_order_relaxed);
+            }
+        }
+    }
+    return positions;
+}
+
+// The table's key for s: its Zobrist key, with the score and round that
+// leaves out mixed in, since what a playout from s is worth depends on
+// them too
+static uint64_t positionKey(const GameState *s)
+{
+    uint64_t z = ((uint64_t)(unsigned short)s->score << 16 |
+                  (unsigned short)s->round) + MIX_STEP;
+    z = (z ^ (z >> 30)) * MIX_1;
+    z = (z ^ (z >> 27)) * MIX_2;
+    return s->key ^ z ^ (z >> 31);
+}
+
+// The table's key for Dracula playing move from the position with key
+// position
+static uint64_t edgeKey(uint64_t position, LocationID move)
+{
+    uint64_t z = position + (uint64_t)(move + 1) * MIX_STEP;
+    z = (z ^ (z >> 30)) * MIX_1;
+    z = (z ^ (z >> 27)) * MIX_2;
+    return z ^ (z >> 31);
+}
+
+// Counts another playout, worth reward, for the table entry key
+static void addToEdge(TreeMcts m, Searcher *t, uint64_t key,
+                      long long reward)
+{
+    addTable(m->table, key, ((uint64_t)1 << EDGE_VISIT_SHIFT) + reward,
+             (uint64_t)MAX_EDGE_VISITS << EDGE_VISIT_SHIFT, &t->table);
+}
+
+// The first of node n's children, adding them if it's time to, or less
+// than zero if it has none to go down to
+// Only give a node children once it's been played out from, and only
+// the thread that claims it does
+static int children(TreeMcts m, int n, const GameState *s)
+{
+    Node *node = &m->nodes[n];
+    int first = atomic_load_explicit(&node->firstChild, memory_order_acquire);
+    if(first == NO_NODE &&
+       atomic_load_explicit(&node->visits, memory_order_relaxed) >
+       VIRTUAL_LOSS) {
+        if(atomic_compare_exchange_strong(&node->firstChild, &first,
+                                          EXPANDING)) {
+            first = expand(m, n, s);
+            atomic_store_explicit(&node->firstChild, first,
+                                  memory_order_release);
+        }
+    }
+    return first;
+}
+
+// Takes a block of nodes for a child for each move Dracula can make from
+// s, and sets them up; returns the first, or NO_ROOM if there wasn't room
+// Doesn't publish them: whoever called it does that
+static int expand(TreeMcts m, int n, const GameState *s)
+{
+    LocationID moves[MAX_STATE_MOVES];
+    LocationID dests[MAX_STATE_MOVES];
+    int numMoves = draculaMoves(s, moves, dests);
+
+    // once the pool's run out, stop taking from it
+    int first = NO_ROOM;
+    if(atomic_load_explicit(&m->numNodes, memory_order_relaxed) + numMoves <=
+       m->maxNodes) {
+        first = atomic_fetch_add_explicit(&m->numNodes, numMoves,
+                                          memory_order_relaxed);
+        if(first + numMoves <= m->maxNodes) {
+            int i;
+            for(i = 0; i < numMoves; i++) {
+                newNode(&m->nodes[first + i], moves[i]);
+            }
+            m->nodes[n].numChildren = numMoves;
+        } else {
+            first = NO_ROOM;
+        }
+    }
+    return first;
+}
+
+// UCT: the child with the best upper confidence bound, counting the
+// playouts still on their way as losses
+// Each child is judged on its move's statistics from the position the
+// playout is in (with key position) if it's been tried from there,
+// otherwise on its own
+static int selectChild(TreeMcts m, Searcher *t, int n, int first,
+                       uint64_t position)
+{
+    const Node *node = &m->nodes[n];
+    int last = first + node->numChildren;
+
+    int visits[MAX_STATE_MOVES];
+    long long value[MAX_STATE_MOVES];
+    int parentVisits = 0;
+    int c;
+    for(c = first; c < last; c++) {
+        Node *child = &m->nodes[c];
+        int i = c - first;
+        uint64_t data;
+        if(probeTable(m->table, edgeKey(position, child->move), &data,
+                      &t->table)) {
+            visits[i] = (data >> EDGE_VISIT_SHIFT) + VIRTUAL_LOSS *
+                atomic_load_explicit(&child->pending, memory_order_relaxed);
+            value[i] = data & EDGE_TOTAL_MASK;
+        } else {
+            visits[i] = atomic_load_explicit(&child->visits,
+                                             memory_order_relaxed);
+            value[i] = atomic_load_explicit(&child->value,
+                                            memory_order_relaxed);
+        }
+        parentVisits += visits[i];
+    }
+    double logVisits = log(parentVisits + 1);
+
+    // any that haven't been tried come first
+    int best = NO_NODE;
+    for(c = first; c < last && best == NO_NODE; c++) {
+        if(visits[c - first] == 0) {
+            best = c;
+        }
+    }
+
+    if(best == NO_NODE) {
+        double bestBound = 0;
+        for(c = first; c < last; c++) {
+            int i = c - first;
+            double bound = (double)value[i] / REWARD_UNITS / visits[i] +
+                           EXPLORATION * sqrt(logVisits / visits[i]);
+            if(best == NO_NODE || bound > bestBound) {
+                best = c;
+                bestBound = bound;
+            }
+        }
+    }
+    return best;
+}
+
+// Decoupled UCT: the hunter's own choice of arm, on their own statistics
+static int selectArm(Node *node, PlayerID hunter)
+{
+    int visits[NUM_ARMS];
+    int total = 0;
+    int a;
+    for(a = 0; a < NUM_ARMS; a++) {
+        visits[a] = atomic_load_explicit(&node->hunterVisits[hunter][a],
+                                         memory_order_relaxed);
+        total += visits[a];
+    }
+    double logVisits = log(total + 1);
+
+    // any they haven't tried come first
+    int best = NO_ARM;
+    for(a = 0; a < NUM_ARMS && best == NO_ARM; a++) {
+        if(visits[a] == 0) {
+            best = a;
+        }
+    }
+
+    if(best == NO_ARM) {
+        double bestBound = 0;
+        for(a = 0; a < NUM_ARMS; a++) {
+            long long value = atomic_load_explicit(
+                &node->hunterValue[hunter][a], memory_order_relaxed);
+            double bound = (double)value / REWARD_UNITS / visits[a] +
+                           EXPLORATION * sqrt(logVisits / visits[a]);
+            if(best == NO_ARM || bound > bestBound) {
+                best = a;
+                bestBound = bound;
+            }
+        }
+    }
+    return best;
+}
+
+// The place an arm takes a hunter to
+static LocationID armMove(const GameState *s, PlayerID hunter, int arm)
+{
+    LocationID move = s->location[hunter];
+    if(arm != ARM_REST) {
+        LocationID flank;
+        LocationID chase = chaseMove(s, hunter, s->location[PLAYER_DRACULA],
+                                     &flank);
+        move = (arm == ARM_CHASE) ? chase : flank;
+    }
+    return move;
+}
+
+// The root's most tried child
+static int bestChild(TreeMcts m)
+{
+    const Node *root = &m->nodes[ROOT];
+    int first = atomic_load(&root->firstChild);
+    int best = first;
+    int c;
+    for(c = first + 1; c < first + root->numChildren; c++) {
+        if(atomic_load(&m->nodes[c].visits) >
+           atomic_load(&m->nodes[best].visits)) {
+            best = c;
+        }
+    }
+    return best;
+}
+
+// How the search is going, as a message
+static void report(TreeMcts m, Anytime clock, PlayerMessage message)
+{
+    double secs = msecsUsed(clock) / MSECS_PER_SEC;
+    TableStats table;
+    treeMctsTableStats(m, &table);
+    snprintf(message, MESSAGE_SIZE,
+             "%lld playouts in one tree on %d threads, %.0f nodes/sec, "
+             "%.0f%% table hits",
+             treeMctsPlayouts(m), treeMctsThreads(m),
+             (secs > 0) ? treeMctsNodes(m) / secs : 0,
+             (table.probes > 0) ? 100.0 * table.hits / table.probes : 0);
+}
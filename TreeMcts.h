@@ -0,0 +1,70 @@
+// TreeMcts.h ... tree parallel Monte Carlo tree search for Dracula's move
+// The same search as DracMcts.h, but with one tree that every thread goes
+// down at once, so the threads' playouts add up to one deeper tree rather
+// than several shallow ones. Statistics are kept with atomic counters, a
+// node's children are added by whichever thread claims it first, and a
+// thread on its way down counts its visit before it knows the result (a
+// virtual loss), so the others tend to try something else meanwhile
+// Dracula's moves are also scored position by position in a
+// transposition table the threads share, so wherever in the tree a
+// position comes up again (most often by the hunters replying as they
+// did before), its moves are chosen on everything played out from it
+// With more than one thread, what the others do in the meantime depends
+// on timing, so the same search can give different moves; on one thread
+// it's as repeatable as DracMcts
+
+#ifndef TREE_MCTS_H
+#define TREE_MCTS_H
+
+#include <stdint.h>
+#include "Globals.h"
+#include "Places.h"
+#include "GameState.h"
+#include "Anytime.h"
+#include "TransTable.h"
+
+typedef struct treeMcts *TreeMcts;
+
+// newTreeMcts() makes a search on numThreads threads, with room for
+//   maxNodes tree nodes between them
+// seed starts the random numbers; each thread gets its own from it
+
+TreeMcts newTreeMcts(int maxNodes, int numThreads, uint64_t seed);
+
+// disposeTreeMcts() frees all memory allocated for toBeDeleted
+
+void disposeTreeMcts(TreeMcts toBeDeleted);
+
+// searchTreeMcts() searches from root, where it must be Dracula's turn,
+//   until clock's time is up or maxPlayouts playouts have been run (0 for
+//   no limit), offering its best move to clock every so often
+// Starts a new tree every time
+// Returns the best move: the one most often tried from root
+
+LocationID searchTreeMcts(TreeMcts m, const GameState *root, Anytime clock,
+                          long long maxPlayouts);
+
+// treeMctsPlayouts() gives how many playouts the last search ran
+
+long long treeMctsPlayouts(TreeMcts m);
+
+// treeMctsNodes() gives how many positions the last search went through,
+//   in the tree and in the playouts together
+
+long long treeMctsNodes(TreeMcts m);
+
+// treeMctsTreeSize() gives how many nodes the last search's tree had
+
+int treeMctsTreeSize(TreeMcts m);
+
+// treeMctsTableStats() sets stats to how the last search used its
+//   transposition table, all threads together
+
+void treeMctsTableStats(TreeMcts m, TableStats *stats);
+
+// treeMctsThreads() gives how many threads the search runs on (fewer than
+//   asked for if the system wouldn't start them all)
+
+int treeMctsThreads(TreeMcts m);
+
+#endif
@@ -0,0 +1,152 @@
+// Workers.c ... Workers ADT implementation
+// The threads sleep on a condition variable until the job count goes up,
+// and the last one to finish a job wakes whoever handed it out
+
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include "Globals.h"
+#include "Workers.h"
+
+typedef struct helper {
+    Workers workers;
+    int index;
+    pthread_t thread;
+} Helper;
+
+struct workers {
+    // the threads other than this one: numWorkers - 1 of them
+    Helper *helpers;
+    int numWorkers;
+
+    pthread_mutex_t lock;
+    pthread_cond_t jobReady;
+    pthread_cond_t jobDone;
+
+    // the job in hand; jobs counts them, so a thread can tell a new one
+    // from the last, and running is how many threads are still on it
+    WorkerJob job;
+    void *data;
+    long jobs;
+    int running;
+    int quitting;
+};
+
+static void *helperMain(void *arg);
+
+// Starts numWorkers - 1 threads
+Workers newWorkers(int numWorkers)
+{
+    assert(numWorkers > 0);
+
+    Workers w = malloc(sizeof(struct workers));
+    assert(w != NULL);
+    w->helpers = malloc(numWorkers * sizeof(Helper));
+    assert(w->helpers != NULL);
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->jobReady, NULL);
+    pthread_cond_init(&w->jobDone, NULL);
+    w->job = NULL;
+    w->data = NULL;
+    w->jobs = 0;
+    w->running = 0;
+    w->quitting = FALSE;
+
+    // stop at the first thread that won't start, and make do without
+    w->numWorkers = 1;
+    int ok = TRUE;
+    while(ok && w->numWorkers < numWorkers) {
+        Helper *h = &w->helpers[w->numWorkers - 1];
+        h->workers = w;
+        h->index = w->numWorkers;
+        ok = (pthread_create(&h->thread, NULL, helperMain, h) == 0);
+        if(ok) {
+            w->numWorkers++;
+        }
+    }
+
+    return w;
+}
+
+// Stops the threads, and frees all memory allocated for toBeDeleted
+void disposeWorkers(Workers toBeDeleted)
+{
+    assert(toBeDeleted != NULL);
+
+    pthread_mutex_lock(&toBeDeleted->lock);
+    toBeDeleted->quitting = TRUE;
+    pthread_cond_broadcast(&toBeDeleted->jobReady);
+    pthread_mutex_unlock(&toBeDeleted->lock);
+
+    int i;
+    for(i = 0; i < toBeDeleted->numWorkers - 1; i++) {
+        pthread_join(toBeDeleted->helpers[i].thread, NULL);
+    }
+
+    pthread_cond_destroy(&toBeDeleted->jobDone);
+    pthread_cond_destroy(&toBeDeleted->jobReady);
+    pthread_mutex_destroy(&toBeDeleted->lock);
+    free(toBeDeleted->helpers);
+    free(toBeDeleted);
+}
+
+// How many workers there are
+int numWorkers(Workers w)
+{
+    assert(w != NULL);
+    return w->numWorkers;
+}
+
+// Runs job on every worker, and waits for them all
+void runWorkers(Workers w, WorkerJob job, void *data)
+{
+    assert(w != NULL);
+    assert(job != NULL);
+
+    pthread_mutex_lock(&w->lock);
+    w->job = job;
+    w->data = data;
+    w->jobs++;
+    w->running = w->numWorkers - 1;
+    pthread_cond_broadcast(&w->jobReady);
+    pthread_mutex_unlock(&w->lock);
+
+    job(0, data);
+
+    pthread_mutex_lock(&w->lock);
+    while(w->running > 0) {
+        pthread_cond_wait(&w->jobDone, &w->lock);
+    }
+    pthread_mutex_unlock(&w->lock);
+}
+
+// A thread: waits for each job, does its share, and says when it's done
+static void *helperMain(void *arg)
+{
+    Helper *h = arg;
+    Workers w = h->workers;
+    long done = 0;
+
+    pthread_mutex_lock(&w->lock);
+    while(!w->quitting) {
+        if(w->jobs == done) {
+            pthread_cond_wait(&w->jobReady, &w->lock);
+        } else {
+            done = w->jobs;
+            WorkerJob job = w->job;
+            void *data = w->data;
+            pthread_mutex_unlock(&w->lock);
+
+            job(h->index, data);
+
+            pthread_mutex_lock(&w->lock);
+            w->running--;
+            if(w->running == 0) {
+                pthread_cond_signal(&w->jobDone);
+            }
+        }
+    }
+    pthread_mutex_unlock(&w->lock);
+
+    return NULL;
+}
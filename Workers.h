@@ -0,0 +1,37 @@
+// Workers.h ... a few threads to share a search between
+// The threads are started once and wait between jobs, so a search can
+// hand them a short job many times a turn without paying to start them
+// again. The thread that makes the workers is always worker 0, and takes
+// its share of every job like the rest
+
+#ifndef WORKERS_H
+#define WORKERS_H
+
+typedef struct workers *Workers;
+
+// One worker's share of a job
+// worker is which one is running it, from 0 to numWorkers() - 1, and
+//   data is whatever was given to runWorkers()
+
+typedef void (*WorkerJob)(int worker, void *data);
+
+// newWorkers() starts numWorkers - 1 threads to work alongside this one
+// If the system won't start that many, there are fewer workers
+
+Workers newWorkers(int numWorkers);
+
+// disposeWorkers() stops the threads and frees all memory allocated for
+//   toBeDeleted
+
+void disposeWorkers(Workers toBeDeleted);
+
+// numWorkers() gives how many workers there are, this thread included
+
+int numWorkers(Workers w);
+
+// runWorkers() runs job on every worker at once, and returns when they've
+//   all finished it
+
+void runWorkers(Workers w, WorkerJob job, void *data);
+
+#endif
@@ -1,35 +1,91 @@
 // dracula.c
 // Implementation of your "Fury of Dracula" Dracula AI
+// Monte Carlo tree search (see DracMcts.h), run against the clock
+// Build with -DTREE_PARALLEL to have the threads share one tree instead
+// (see TreeMcts.h); only that search keeps a transposition table
 
 #include <stdlib.h>
 #include <stdio.h>
 #include "Game.h"
 #include "DracView.h"
+#include "GameState.h"
+#include "Map.h"
+#include "Playout.h"
+#include "Anytime.h"
+#include "DracMcts.h"
+#include "TreeMcts.h"
+#include "dracula.h"
 
-void decideDraculaMove(DracView gameState) {
-   LocationID nextMove = nameToID("CASTLE_DRACULA");
-   LocationID trail[TRAIL_SIZE];
-   int numLoc = 0;
-   int *numLocations = &numLoc;
-   LocationID *moveList = whereCanIgo(gameState, numLocations, TRUE, TRUE);
-   if (numLoc != 0) {
-       // At the moment, just found out valid moves and pick a random one.
-	   giveMeTheTrail(gameState, PLAYER_DRACULA, trail);
-	   // Compare trail and possible moves, removing those that appear int the trail
-	   int i, j;
-	   for (i = 0; i < TRAIL_SIZE; i++) {
-	      for (j = 0; j < *numLocations; j++) {
-	         if (trail[i] == moveList[j]) {
-	            moveList[j] = NOWHERE;
-	         }
-	      }
-	   }
-   }
-   int j;
-   for (j = 0; j < *numLocations; j++) {
-      if (moveList[j] != NOWHERE) {
-         nextMove = moveList[j];
-      }
-   }
-   registerBestPlay(IDToAbbrev(nextMove),"We like pink fluffy unicorns!");
+// how many tree nodes the search has room for
+#define MCTS_NODES (1 << 18)
+
+// how many threads to search on; build with -DSEARCH_THREADS=n to suit
+// the machine (with a tree each, the same number always plays the same
+// way)
+#ifndef SEARCH_THREADS
+#define SEARCH_THREADS 4
+#endif
+
+// where the search's random numbers start
+#define MCTS_SEED 1927
+
+#define MESSAGE "We like pink fluffy unicorns!"
+
+static LocationID quickMove(const GameState *state);
+
+void decideDraculaMove(DracView gameState)
+{
+    Anytime clock = newAnytime(LIMIT_LIMIT_MSECS, DEFAULT_SAFETY_MSECS);
+    GameState state;
+    giveMeTheState(gameState, &state);
+
+    // something sensible, straight away, in case the search is late
+    offerMove(clock, quickMove(&state), 0, 0, MESSAGE);
+
+#ifdef TREE_PARALLEL
+    TreeMcts search = newTreeMcts(MCTS_NODES, SEARCH_THREADS,
+                                  MCTS_SEED + state.round);
+    searchTreeMcts(search, &state, clock, 0);
+    disposeTreeMcts(search);
+#else
+    DracMcts search = newDracMcts(MCTS_NODES, SEARCH_THREADS,
+                                  MCTS_SEED + state.round);
+    searchMcts(search, &state, clock, 0);
+    disposeDracMcts(search);
+#endif
+
+    disposeAnytime(clock);
+}
+
+// The move to wherever the hunters need the most turns to get to, and of
+// those, the one it costs least blood to get back to the castle from
+static LocationID quickMove(const GameState *state)
+{
+    LocationID moves[MAX_STATE_MOVES];
+    LocationID dests[MAX_STATE_MOVES];
+    int numMoves = draculaMoves(state, moves, dests);
+
+    LocationID best = moves[0];
+    int bestTurns = -1;
+    int bestBlood = 0;
+    int i;
+    for(i = 0; i < numMoves; i++) {
+        // the hunters' next turns are next round's
+        int turns = NUM_MAP_LOCATIONS;
+        PlayerID h;
+        for(h = 0; h < PLAYER_DRACULA; h++) {
+            int t = turnsBetween(state->location[h], dests[i], h,
+                                 state->round + 1);
+            if(t < turns) {
+                turns = t;
+            }
+        }
+        int blood = draculaBlood(dests[i], CASTLE_DRACULA);
+        if(turns > bestTurns || (turns == bestTurns && blood < bestBlood)) {
+            best = moves[i];
+            bestTurns = turns;
+            bestBlood = blood;
+        }
+    }
+    return best;
 }
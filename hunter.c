@@ -1,27 +1,184 @@
 // hunter.c
 // Implementation of your "Fury of Dracula" hunter AI
+// Information set Monte Carlo tree search (see HunterMcts.h) over trails
+// Dracula could really have left, run against the clock
+// The hunters share out where Dracula might be between them (see
+// HunterRoles.h), and while a hunter is far from their share the search
+// only looks at moves that head for it
 
 #include <stdlib.h>
 #include <stdio.h>
 #include "Game.h"
 #include "HunterView.h"
+#include "GameState.h"
+#include "Map.h"
+#include "TrailEnum.h"
+#include "Anytime.h"
+#include "Random.h"
+#include "Playout.h"
+#include "HunterMcts.h"
+#include "HunterRoles.h"
+#include "hunter.h"
 
-void decideHunterMove(HunterView gameState) {
+// rest rather than move with this much life or less
+#define LOW_HEALTH 3
+
+// how many of Dracula's possible trails to search over, and how many to
+// keep while picking them (past that they're picked in a second pass)
+#define NUM_WORLDS 1024
+#define MAX_STORED_TRAILS (1 << 16)
+
+// how many turns from the middle of their region a hunter can be and
+// still search every move
+#define ROLE_RADIUS 2
+
+// how many tree nodes the search has room for
+#define MCTS_NODES (1 << 20)
+
+// how many threads to search on; build with -DSEARCH_THREADS=n to suit
+// the machine (the same number always plays the same way)
+#ifndef SEARCH_THREADS
+#define SEARCH_THREADS 4
+#endif
+
+// where the random numbers start; the round and player are added so each
+// turn gets its own, but the same game always gives the same moves
+#define SEARCH_SEED 1927
+
+#define MESSAGE "The trill of the hunt!!!"
+
+static LocationID mostCentral(HunterView gameState);
+static LocationID myTarget(HunterView gameState);
+static LocationID towardTarget(HunterView gameState, LocationID target);
+static void search(HunterView gameState, LocationID target,
+                   const LocationID cands[], int numCands, Anytime clock);
+
+void decideHunterMove(HunterView gameState)
+{
+    Anytime clock = newAnytime(LIMIT_LIMIT_MSECS, DEFAULT_SAFETY_MSECS);
     PlayerID player = whoAmI(gameState);
-    LocationID nextMove = whereIs(gameState, player);
-    LocationID trail[TRAIL_SIZE];
-    int numLoc = 0;
-    int *numLocations = &numLoc;
-    LocationID *moveList = whereCanIgo(gameState, numLocations, TRUE, TRUE, TRUE);
-    if (numLoc != 0 && howHealthyIs(gameState, player) > 3) {
-        giveMeTheTrail(gameState, player, trail);
-	// Compare trail and possible moves, removing those that appear int the trail
-        int j;
-        for (j = 0; j < *numLocations; j++) {
-            if (moveList[j] != NOWHERE) {
-                nextMove = moveList[j];
+    LocationID here = whereIs(gameState, player);
+
+    if(here == NOWHERE) {
+        // nothing to go on yet: start where we can get anywhere quickly
+        offerMove(clock, mostCentral(gameState), 0, 0, MESSAGE);
+    } else if(howHealthyIs(gameState, player) <= LOW_HEALTH) {
+        offerMove(clock, here, 0, 0, MESSAGE);
+    } else {
+        LocationID cands[NUM_MAP_LOCATIONS];
+        int numCands = setToArray(whereCanIgoSet(gameState, TRUE, TRUE, TRUE),
+                                  cands);
+
+        // the cheap answer first, then keep improving on it
+        LocationID target = myTarget(gameState);
+        offerMove(clock, towardTarget(gameState, target), 0, 0, MESSAGE);
+        if(numCands > 1) {
+            search(gameState, target, cands, numCands, clock);
+        }
+    }
+    disposeAnytime(clock);
+}
+
+// The place with the fewest hops to everywhere else, that no other hunter
+// has taken
+static LocationID mostCentral(HunterView gameState)
+{
+    LocationSet taken = setEmpty();
+    PlayerID p;
+    for(p = 0; p < PLAYER_DRACULA; p++) {
+        LocationID there = whereIs(gameState, p);
+        if(there != NOWHERE) {
+            setAdd(&taken, there);
+        }
+    }
+
+    LocationID best = NOWHERE;
+    int bestTotal = 0;
+    LocationID v;
+    for(v = MIN_MAP_LOCATION; v <= MAX_MAP_LOCATION; v++) {
+        if(!setHas(taken, v) && v != ST_JOSEPH_AND_ST_MARYS) {
+            int total = 0;
+            LocationID w;
+            for(w = MIN_MAP_LOCATION; w <= MAX_MAP_LOCATION; w++) {
+                total += hopsBetween(v, w);
+            }
+            if(best == NOWHERE || total < bestTotal) {
+                best = v;
+                bestTotal = total;
+            }
+        }
+    }
+    return best;
+}
+
+// The middle of the region this hunter has been given, or if there's
+// none, where Dracula most likely is (NOWHERE if we've no idea)
+static LocationID myTarget(HunterView gameState)
+{
+    double weight[NUM_MAP_LOCATIONS];
+    LocationID hunters[PLAYER_DRACULA];
+    giveMeTheRoundStart(gameState, weight, hunters);
+    Roles roles;
+    assignRoles(weight, hunters, giveMeTheRound(gameState), &roles);
+
+    LocationID target = NOWHERE;
+    int role = roles.role[whoAmI(gameState)];
+    if(role != NO_ROLE) {
+        target = roles.centre[role];
+    } else if(mostLikelyLocations(gameState, 1, &target) != 1) {
+        target = NOWHERE;
+    }
+    return target;
+}
+
+// The first move on the way to target in the fewest turns
+static LocationID towardTarget(HunterView gameState, LocationID target)
+{
+    PlayerID me = whoAmI(gameState);
+    LocationID best = whereIs(gameState, me);
+
+    if(target != NOWHERE) {
+        best = hunterNextHop(best, target, me, giveMeTheRound(gameState));
+    }
+    return best;
+}
+
+// Searches over a sample of the trails Dracula could have left
+static void search(HunterView gameState, LocationID target,
+                   const LocationID cands[], int numCands, Anytime clock)
+{
+    uint64_t seed = SEARCH_SEED +
+        giveMeTheRound(gameState) * NUM_PLAYERS + whoAmI(gameState);
+    RandomState rng;
+    seedRandom(&rng, seed);
+
+    TrailHypothesis worlds[NUM_WORLDS];
+    TrailEnum trails = possibleTrails(gameState, MAX_STORED_TRAILS);
+    int numWorlds = sampleTrails(trails, &rng, NUM_WORLDS, worlds);
+    disposeTrailEnum(trails);
+
+    if(numWorlds > 0) {
+        GameState root;
+        giveMeTheState(gameState, &root);
+
+        HunterMcts m = newHunterMcts(MCTS_NODES, SEARCH_THREADS, seed);
+
+        // far from our region, only the moves that close in on it
+        PlayerID me = whoAmI(gameState);
+        LocationID here = whereIs(gameState, me);
+        Round round = giveMeTheRound(gameState);
+        int turns = turnsBetween(here, target, me, round);
+        if(target != NOWHERE && turns > ROLE_RADIUS) {
+            LocationSet closer = setEmpty();
+            int i;
+            for(i = 0; i < numCands; i++) {
+                if(turnsBetween(cands[i], target, me, round + 1) < turns) {
+                    setAdd(&closer, cands[i]);
+                }
             }
+            focusHunterMcts(m, closer);
         }
+        searchHunterMcts(m, &root, worlds, numWorlds, clock, 0);
+        disposeHunterMcts(m);
     }
-    registerBestPlay(IDToAbbrev(nextMove),"The trill of the hunt!!!");
 }
@@ -0,0 +1,134 @@
+// mctsbench.c ... how Dracula's searches scale with threads
+// Runs each search from the same position for the same time on 1, 2, ...
+// threads, and prints how fast it went, how big its tree grew and, for
+// the shared tree, how often its leaves were found in the table:
+//   ./mctsbench [maxThreads [msecs]]
+// maxThreads defaults to the number of processors, msecs to a turn's worth
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "Globals.h"
+#include "Game.h"
+#include "DracView.h"
+#include "GameState.h"
+#include "Anytime.h"
+#include "PlayDecoder.h"
+#include "DracMcts.h"
+#include "TreeMcts.h"
+
+#define MCTS_NODES (1 << 18)
+#define MCTS_SEED 1927
+
+#define MSECS_PER_SEC 1000.0
+
+// a few rounds in, with the hunters closing on Dracula in the east
+#define PAST_PLAYS "GMN.... SPL.... HAM.... MGE.... DBU.V.. " \
+                   "GLO.... SLI.... HNS.... MMR.... DCOT... " \
+                   "GPL.... SMN.... HED.... MGO.... DSTT... " \
+                   "GLO.... SNU.... HAM.... MMI...."
+#define NUM_PAST_PLAYS 19
+
+// how one run went
+typedef struct result {
+    double rate;
+    int treeSize;
+    double hits;
+    LocationID move;
+} Result;
+
+static Result benchRoot(const GameState *s, int numThreads, int msecs);
+static Result benchTree(const GameState *s, int numThreads, int msecs);
+static void printResult(Result r, Result base);
+
+int main(int argc, char *argv[])
+{
+    int maxThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    int msecs = LIMIT_LIMIT_MSECS - DEFAULT_SAFETY_MSECS;
+    if(argc > 1) {
+        maxThreads = atoi(argv[1]);
+    }
+    if(argc > 2) {
+        msecs = atoi(argv[2]);
+    }
+    if(maxThreads < 1 || msecs < 1) {
+        fprintf(stderr, "usage: %s [maxThreads [msecs]]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    PlayerMessage messages[NUM_PAST_PLAYS] = { "" };
+    DracView view = newDracView(PAST_PLAYS, messages);
+    GameState s;
+    giveMeTheState(view, &s);
+    disposeDracView(view);
+
+    printf("%7s  %-35s  %-41s\n", "", "a tree each (DracMcts)",
+           "one tree (TreeMcts)");
+    printf("%7s  %11s %7s %9s %5s  %11s %7s %9s %5s %5s\n", "threads",
+           "playouts/s", "speedup", "nodes", "move",
+           "playouts/s", "speedup", "nodes", "move", "hits");
+
+    Result rootBase, treeBase;
+    int t;
+    for(t = 1; t <= maxThreads; t++) {
+        Result root = benchRoot(&s, t, msecs);
+        Result tree = benchTree(&s, t, msecs);
+        if(t == 1) {
+            rootBase = root;
+            treeBase = tree;
+        }
+        printf("%7d ", t);
+        printResult(root, rootBase);
+        printResult(tree, treeBase);
+        printf(" %4.0f%%\n", tree.hits);
+    }
+    return EXIT_SUCCESS;
+}
+
+// The engine's hook; the benchmark has nowhere to send moves
+void registerBestPlay(char *play, PlayerMessage message)
+{
+}
+
+// One run of the search with a tree for each thread
+static Result benchRoot(const GameState *s, int numThreads, int msecs)
+{
+    Anytime clock = newAnytime(msecs, 0);
+    DracMcts m = newDracMcts(MCTS_NODES, numThreads, MCTS_SEED);
+
+    Result r;
+    r.move = searchMcts(m, s, clock, 0);
+    r.rate = mctsPlayouts(m) / (msecsUsed(clock) / MSECS_PER_SEC);
+    r.treeSize = mctsTreeSize(m);
+    r.hits = 0;
+
+    disposeDracMcts(m);
+    disposeAnytime(clock);
+    return r;
+}
+
+// One run of the search with one tree between the threads
+static Result benchTree(const GameState *s, int numThreads, int msecs)
+{
+    Anytime clock = newAnytime(msecs, 0);
+    TreeMcts m = newTreeMcts(MCTS_NODES, numThreads, MCTS_SEED);
+
+    Result r;
+    r.move = searchTreeMcts(m, s, clock, 0);
+    r.rate = treeMctsPlayouts(m) / (msecsUsed(clock) / MSECS_PER_SEC);
+    r.treeSize = treeMctsTreeSize(m);
+    TableStats table;
+    treeMctsTableStats(m, &table);
+    r.hits = (table.probes > 0) ? 100.0 * table.hits / table.probes : 0;
+
+    disposeTreeMcts(m);
+    disposeAnytime(clock);
+    return r;
+}
+
+// A run's columns, with its speed against the run on one thread
+static void printResult(Result r, Result base)
+{
+    printf(" %11.0f %6.2fx %9d %5s", r.rate, r.rate / base.rate, r.treeSize,
+           encodeMove(r.move));
+}
@@ -0,0 +1,772 @@
+// mkmap.c ... generates MapData.c from the connection list
+// Run by the Makefile; writes C source for the map tables to stdout so that
+// none of this has to be worked out again when a player starts up
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "Globals.h"
+#include "Map.h"
+#include "MapData.h"
+#include "Places.h"
+
+// the map being built; too big to live on the stack
+static struct MapRep theMap;
+
+// how much of moveArcs buildMoves() used
+static int numMoveArcs = 0;
+
+// more blood than Dracula could ever lose on the way anywhere
+#define NO_COST 1000
+
+// the most ways for Dracula to get from one place to another that each
+// lose less blood than any quicker one
+#define MAX_PAIR_COSTS 16
+
+// the abbreviation hash being built
+static struct AbbrevHash theHash;
+
+static void buildMap(struct MapRep *g);
+static void addLink(struct MapRep *g, LocationID start, LocationID end,
+                    TransportID type);
+static void addConnections(struct MapRep *g);
+static void buildArcs(struct MapRep *g);
+static void buildHops(struct MapRep *g);
+static void buildMoves(struct MapRep *g);
+static void buildTurns(struct MapRep *g);
+static void buildDracula(struct MapRep *g);
+static int draculaFrom(struct MapRep *g, LocationID src, int n);
+static int addMoveList(struct MapRep *g, int n, LocationSet s);
+static void printSet(LocationSet s);
+static void printTable(signed char table[NUM_RAIL_HOPS][NUM_MAP_LOCATIONS]
+                                         [NUM_MAP_LOCATIONS]);
+static void printGrid(signed char grid[NUM_MAP_LOCATIONS][NUM_MAP_LOCATIONS],
+                      const char *indent);
+static void printMap(struct MapRep *g);
+static void buildHash(struct AbbrevHash *h);
+static int tryHash(struct AbbrevHash *h, uint32_t mult);
+static void printHash(struct AbbrevHash *h);
+
+int main(void)
+{
+    buildMap(&theMap);
+    printMap(&theMap);
+    buildHash(&theHash);
+    printHash(&theHash);
+    return EXIT_SUCCESS;
+}
+
+// Fill in the map from the connection list
+static void buildMap(struct MapRep *g)
+{
+    int t, v;
+    g->nV = NUM_MAP_LOCATIONS;
+    g->nE = 0;
+    for (t = 0; t < NUM_TRANSPORT; t++) {
+        for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+            g->adj[t][v] = setEmpty();
+        }
+    }
+    g->seas = setEmpty();
+    for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+        if (idToType(v) == SEA) setAdd(&g->seas, v);
+    }
+    addConnections(g);
+    buildArcs(g);
+    buildHops(g);
+    buildMoves(g);
+    buildTurns(g);
+    buildDracula(g);
+}
+
+// Add a new edge to the Map/Graph
+static void addLink(struct MapRep *g, LocationID start, LocationID end, TransportID type)
+{
+    assert(g != NULL);
+    // don't add edges twice
+    if (!setHas(g->adj[type][start], end)) {
+        g->nE++;
+    }
+    // both ways; undirected graph
+    setAdd(&g->adj[type][start], end);
+    setAdd(&g->adj[type][end], start);
+    setAdd(&g->adj[ANY][start], end);
+    setAdd(&g->adj[ANY][end], start);
+}
+
+// Lay the adjacency sets out as CSR neighbour arrays
+static void buildArcs(struct MapRep *g)
+{
+    int t, v, w;
+    for (t = 0; t < NUM_TRANSPORT; t++) {
+        int n = 0;
+        for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+            g->first[t][v] = n;
+            for (w = setNext(g->adj[t][v], 0); w != NOWHERE;
+                 w = setNext(g->adj[t][v], w+1)) {
+                assert(n < MAX_ARCS);
+                g->arcs[t][n++] = w;
+            }
+        }
+        g->first[t][NUM_MAP_LOCATIONS] = n;
+    }
+}
+
+// Breadth first search out of every location, once per transport,
+// expanding a whole frontier at a time with set unions
+static void buildHops(struct MapRep *g)
+{
+    int t, src, v;
+    for (t = 0; t < NUM_TRANSPORT; t++) {
+        for (src = 0; src < NUM_MAP_LOCATIONS; src++) {
+            signed char *dist = g->hops[t][src];
+            LocationSet seen = setEmpty();
+            LocationSet frontier = setEmpty();
+            int d = 0;
+
+            for (v = 0; v < NUM_MAP_LOCATIONS; v++) dist[v] = NO_PATH;
+            setAdd(&frontier, src);
+            while (!setIsEmpty(frontier)) {
+                LocationSet next = setEmpty();
+                for (v = setNext(frontier, 0); v != NOWHERE;
+                     v = setNext(frontier, v+1)) {
+                    dist[v] = d;
+                    next = setUnion(next, g->adj[t][v]);
+                }
+                seen = setUnion(seen, frontier);
+                frontier = setMinus(next, seen);
+                d++;
+            }
+        }
+    }
+}
+
+// Work out every answer to "where can I get to this turn?"
+static void buildMoves(struct MapRep *g)
+{
+    int v, r, f, n = 0;
+    for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+        for (f = 0; f < NUM_MOVE_FLAGS; f++) {
+            // road and sea are single hops, and we can always stay put
+            LocationSet base = setOf(v);
+            if (f & MOVE_ROAD) base = setUnion(base, g->adj[ROAD][v]);
+            if (f & MOVE_SEA) base = setUnion(base, g->adj[BOAT][v]);
+
+            for (r = 0; r < NUM_RAIL_HOPS; r++) {
+                LocationSet s = base;
+                LocationID w;
+                for (w = 0; w < NUM_MAP_LOCATIONS; w++) {
+                    int d = g->hops[RAIL][v][w];
+                    if (d != NO_PATH && d <= r) setAdd(&s, w);
+                }
+                g->hunterMoves[v][r][f] = s;
+                g->hunterStart[v][r][f] = n;
+                n = addMoveList(g, n, s);
+            }
+
+            // dracula never takes the train or checks into the hospital
+            setRemove(&base, ST_JOSEPH_AND_ST_MARYS);
+            g->draculaMoves[v][f] = base;
+            g->draculaStart[v][f] = n;
+            n = addMoveList(g, n, base);
+        }
+    }
+    numMoveArcs = n;
+}
+
+// Append the locations in s to moveArcs, which is n long so far
+static int addMoveList(struct MapRep *g, int n, LocationSet s)
+{
+    assert(n + setSize(s) <= MAX_MOVE_ARCS);
+    return n + setToArray(s, &g->moveArcs[n]);
+}
+
+// Breadth first search back from every location over the time-expanded
+// graph, whose nodes are (place, rail hops this turn): a hunter at v who
+// gets r rail hops is one turn further from w than the nearest place
+// they can move to, where they'll get (r + 1) % NUM_RAIL_HOPS
+static void buildTurns(struct MapRep *g)
+{
+    int dst, r, v, d;
+    for (dst = 0; dst < NUM_MAP_LOCATIONS; dst++) {
+        // reached[r] is everywhere that's no more than d turns from dst
+        // when the first turn gets r rail hops
+        LocationSet reached[NUM_RAIL_HOPS];
+        int grew = TRUE;
+
+        for (r = 0; r < NUM_RAIL_HOPS; r++) {
+            for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+                g->hunterTurns[r][v][dst] = NO_PATH;
+                g->hunterNext[r][v][dst] = NOWHERE;
+            }
+            g->hunterTurns[r][dst][dst] = 0;
+            g->hunterNext[r][dst][dst] = dst;
+            reached[r] = setOf(dst);
+        }
+        for (d = 1; grew; d++) {
+            LocationSet before[NUM_RAIL_HOPS];
+            grew = FALSE;
+            for (r = 0; r < NUM_RAIL_HOPS; r++) before[r] = reached[r];
+            for (r = 0; r < NUM_RAIL_HOPS; r++) {
+                LocationSet then = before[(r + 1) % NUM_RAIL_HOPS];
+                for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+                    LocationSet via = setIntersect(
+                        g->hunterMoves[v][r][MOVE_ROAD | MOVE_SEA], then);
+                    if (!setHas(before[r], v) && !setIsEmpty(via)) {
+                        g->hunterTurns[r][v][dst] = d;
+                        g->hunterNext[r][v][dst] = setNext(via, 0);
+                        setAdd(&reached[r], v);
+                        grew = TRUE;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Work out Dracula's turns and blood from everywhere to everywhere
+static void buildDracula(struct MapRep *g)
+{
+    int src, n = 0;
+    for (src = 0; src < NUM_MAP_LOCATIONS; src++) {
+        n = draculaFrom(g, src, n);
+    }
+    g->costStart[NUM_MAP_LOCATIONS * NUM_MAP_LOCATIONS] = n;
+}
+
+// Dracula's turns and blood from src, and his lists of costs, which go
+// into dracCosts from n on; returns how long dracCosts is now
+// A route that's best for its number of turns never goes round a loop
+// (that costs turns and gains no blood, the castle only counting once),
+// so it's a path through the (place, had the castle's blood) pairs, and
+// there's no need to look further than twice as many turns as places
+static int draculaFrom(struct MapRep *g, LocationID src, int n)
+{
+    // cost[c][v] is the least blood lost to be at v after t turns, where c
+    // is whether he's been to the castle on the way; least[v] is the least
+    // after any number of turns up to t
+    int cost[2][NUM_MAP_LOCATIONS];
+    int least[NUM_MAP_LOCATIONS];
+    DracCost found[NUM_MAP_LOCATIONS][MAX_PAIR_COSTS];
+    int numFound[NUM_MAP_LOCATIONS];
+    int c, v, w, t, i;
+
+    for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+        cost[0][v] = cost[1][v] = NO_COST;
+        least[v] = NO_COST;
+        numFound[v] = 0;
+        g->draculaTurns[src][v] = NO_PATH;
+        g->draculaBlood[src][v] = 0;
+    }
+    if (src != ST_JOSEPH_AND_ST_MARYS) cost[0][src] = 0;
+
+    for (t = 0; t <= 2 * NUM_MAP_LOCATIONS; t++) {
+        int next[2][NUM_MAP_LOCATIONS];
+
+        for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+            int blood = (cost[0][v] < cost[1][v]) ? cost[0][v] : cost[1][v];
+            if (blood < least[v]) {
+                assert(numFound[v] < MAX_PAIR_COSTS);
+                found[v][numFound[v]].turns = t;
+                found[v][numFound[v]].blood = blood;
+                numFound[v]++;
+                least[v] = blood;
+                if (g->draculaTurns[src][v] == NO_PATH) {
+                    g->draculaTurns[src][v] = t;
+                }
+                g->draculaBlood[src][v] = blood;
+            }
+            next[0][v] = next[1][v] = NO_COST;
+        }
+
+        // one more turn: he has to move, and never to the hospital
+        for (c = 0; c < 2; c++) {
+            for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+                LocationSet moves = g->draculaMoves[v][MOVE_ROAD | MOVE_SEA];
+                setRemove(&moves, v);
+                if (cost[c][v] == NO_COST) moves = setEmpty();
+                for (w = setNext(moves, 0); w != NOWHERE;
+                     w = setNext(moves, w+1)) {
+                    int after = c;
+                    int blood = cost[c][v];
+                    if (setHas(g->seas, w)) {
+                        blood += LIFE_LOSS_SEA;
+                    } else if (w == CASTLE_DRACULA && c == 0) {
+                        blood -= LIFE_GAIN_CASTLE_DRACULA;
+                        after = 1;
+                    }
+                    if (blood < next[after][w]) next[after][w] = blood;
+                }
+            }
+        }
+        for (c = 0; c < 2; c++) {
+            for (v = 0; v < NUM_MAP_LOCATIONS; v++) cost[c][v] = next[c][v];
+        }
+    }
+
+    for (w = 0; w < NUM_MAP_LOCATIONS; w++) {
+        g->costStart[src * NUM_MAP_LOCATIONS + w] = n;
+        for (i = 0; i < numFound[w]; i++) {
+            assert(n < MAX_DRAC_COSTS);
+            g->dracCosts[n++] = found[w][i];
+        }
+    }
+    return n;
+}
+
+// Write the map out as a C initialiser for mapData
+static void printMap(struct MapRep *g)
+{
+    int t, v, w;
+
+    printf("// MapData.c ... generated by mkmap; do not edit\n\n");
+    printf("#include \"MapData.h\"\n\n");
+    printf("const struct MapRep mapData = {\n");
+    printf("    %d,\n    %d,\n", g->nV, g->nE);
+
+    printf("    {\n");
+    for (t = 0; t < NUM_TRANSPORT; t++) {
+        printf("        {\n");
+        for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+            printf("            ");
+            printSet(g->adj[t][v]);
+            printf(",\n");
+        }
+        printf("        },\n");
+    }
+    printf("    },\n");
+
+    printf("    {\n");
+    for (t = 0; t < NUM_TRANSPORT; t++) {
+        printf("        {");
+        for (v = 0; v <= NUM_MAP_LOCATIONS; v++) {
+            printf("%s%d,", (v % 16 == 0) ? "\n            " : " ",
+                   g->first[t][v]);
+        }
+        printf("\n        },\n");
+    }
+    printf("    },\n");
+
+    printf("    {\n");
+    for (t = 0; t < NUM_TRANSPORT; t++) {
+        printf("        {");
+        for (v = 0; v < g->first[t][NUM_MAP_LOCATIONS]; v++) {
+            printf("%s%d,", (v % 16 == 0) ? "\n            " : " ",
+                   g->arcs[t][v]);
+        }
+        if (v == 0) printf(" 0,");
+        printf("\n        },\n");
+    }
+    printf("    },\n");
+
+    printf("    {\n");
+    for (t = 0; t < NUM_TRANSPORT; t++) {
+        printf("        {\n");
+        for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+            printf("            {");
+            for (w = 0; w < NUM_MAP_LOCATIONS; w++) {
+                printf("%s%d,", (w % 24 == 0) ? "\n                " : " ",
+                       g->hops[t][v][w]);
+            }
+            printf("\n            },\n");
+        }
+        printf("        },\n");
+    }
+    printf("    },\n");
+
+    printf("    {\n");
+    for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+        printf("        {\n");
+        for (t = 0; t < NUM_RAIL_HOPS; t++) {
+            printf("            {");
+            for (w = 0; w < NUM_MOVE_FLAGS; w++) {
+                printf("\n                ");
+                printSet(g->hunterMoves[v][t][w]);
+                printf(",");
+            }
+            printf("\n            },\n");
+        }
+        printf("        },\n");
+    }
+    printf("    },\n");
+
+    printf("    {\n");
+    for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+        printf("        {");
+        for (w = 0; w < NUM_MOVE_FLAGS; w++) {
+            printf("\n            ");
+            printSet(g->draculaMoves[v][w]);
+            printf(",");
+        }
+        printf("\n        },\n");
+    }
+    printf("    },\n");
+
+    printf("    {\n");
+    for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+        printf("        {");
+        for (t = 0; t < NUM_RAIL_HOPS; t++) {
+            printf(" {");
+            for (w = 0; w < NUM_MOVE_FLAGS; w++) {
+                printf(" %d,", g->hunterStart[v][t][w]);
+            }
+            printf(" },");
+        }
+        printf(" },\n");
+    }
+    printf("    },\n");
+
+    printf("    {\n");
+    for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+        printf("        {");
+        for (w = 0; w < NUM_MOVE_FLAGS; w++) {
+            printf(" %d,", g->draculaStart[v][w]);
+        }
+        printf(" },\n");
+    }
+    printf("    },\n");
+
+    printf("    {");
+    for (v = 0; v < numMoveArcs; v++) {
+        printf("%s%d,", (v % 16 == 0) ? "\n        " : " ", g->moveArcs[v]);
+    }
+    printf("\n    },\n");
+
+    printf("    ");
+    printSet(g->seas);
+    printf(",\n");
+
+    printTable(g->hunterTurns);
+    printTable(g->hunterNext);
+    printGrid(g->draculaTurns, "    ");
+    printGrid(g->draculaBlood, "    ");
+
+    printf("    {");
+    for (v = 0; v <= NUM_MAP_LOCATIONS * NUM_MAP_LOCATIONS; v++) {
+        printf("%s%d,", (v % 16 == 0) ? "\n        " : " ", g->costStart[v]);
+    }
+    printf("\n    },\n");
+
+    printf("    {");
+    for (v = 0; v < g->costStart[NUM_MAP_LOCATIONS * NUM_MAP_LOCATIONS];
+         v++) {
+        printf("%s{%d, %d},", (v % 8 == 0) ? "\n        " : " ",
+               g->dracCosts[v].turns, g->dracCosts[v].blood);
+    }
+    printf("\n    },\n");
+
+    printf("};\n");
+}
+
+static void printSet(LocationSet s)
+{
+    printf("{{0x%016llxULL, 0x%016llxULL}}",
+           (unsigned long long)s.bits[0], (unsigned long long)s.bits[1]);
+}
+
+static void printTable(signed char table[NUM_RAIL_HOPS][NUM_MAP_LOCATIONS]
+                                         [NUM_MAP_LOCATIONS])
+{
+    int r;
+
+    printf("    {\n");
+    for (r = 0; r < NUM_RAIL_HOPS; r++) {
+        printGrid(table[r], "        ");
+    }
+    printf("    },\n");
+}
+
+static void printGrid(signed char grid[NUM_MAP_LOCATIONS][NUM_MAP_LOCATIONS],
+                      const char *indent)
+{
+    int v, w;
+
+    printf("%s{\n", indent);
+    for (v = 0; v < NUM_MAP_LOCATIONS; v++) {
+        printf("%s    {", indent);
+        for (w = 0; w < NUM_MAP_LOCATIONS; w++) {
+            if (w % 24 == 0) {
+                printf("\n%s        %d,", indent, grid[v][w]);
+            } else {
+                printf(" %d,", grid[v][w]);
+            }
+        }
+        printf("\n%s    },\n", indent);
+    }
+    printf("%s},\n", indent);
+}
+
+// Find a multiplier that gives every abbreviation a slot of its own
+static void buildHash(struct AbbrevHash *h)
+{
+    uint32_t mult;
+    for (mult = 0x9E3779B1u; !tryHash(h, mult); mult += 2) {
+        ;
+    }
+}
+
+// Fill in the hash with the given multiplier; FALSE if anything collides
+static int tryHash(struct AbbrevHash *h, uint32_t mult)
+{
+    // the moves that aren't places, and what they're written as
+    static const char *others[] = {
+        "C?", "S?", "HI", "D1", "D2", "D3", "D4", "D5", "TP"
+    };
+    static const LocationID otherMoves[] = {
+        CITY_UNKNOWN, SEA_UNKNOWN, HIDE, DOUBLE_BACK_1, DOUBLE_BACK_2,
+        DOUBLE_BACK_3, DOUBLE_BACK_4, DOUBLE_BACK_5, TELEPORT
+    };
+    int numOthers = sizeof(others) / sizeof(others[0]);
+    int i;
+
+    h->mult = mult;
+    for (i = 0; i < ABBREV_HASH_SIZE; i++) {
+        h->keys[i] = 0;
+        h->moves[i] = NOWHERE;
+    }
+    for (i = 0; i < NUM_MAP_LOCATIONS + numOthers; i++) {
+        const char *abbrev = (i < NUM_MAP_LOCATIONS) ?
+            IDToAbbrev(i) : others[i - NUM_MAP_LOCATIONS];
+        uint16_t key = (uint16_t)((unsigned char)abbrev[0] |
+                                  ((unsigned char)abbrev[1] << 8));
+        uint32_t slot = (key * mult) >> (32 - ABBREV_HASH_BITS);
+        if (h->keys[slot] != 0) return FALSE;
+        h->keys[slot] = key;
+        h->moves[slot] = (i < NUM_MAP_LOCATIONS) ?
+            i : otherMoves[i - NUM_MAP_LOCATIONS];
+    }
+    return TRUE;
+}
+
+static void printHash(struct AbbrevHash *h)
+{
+    int i;
+
+    printf("\nconst struct AbbrevHash abbrevHash = {\n");
+    printf("    0x%08xu,\n", (unsigned)h->mult);
+
+    printf("    {");
+    for (i = 0; i < ABBREV_HASH_SIZE; i++) {
+        printf("%s0x%04x,", (i % 12 == 0) ? "\n        " : " ", h->keys[i]);
+    }
+    printf("\n    },\n");
+
+    printf("    {");
+    for (i = 0; i < ABBREV_HASH_SIZE; i++) {
+        printf("%s%d,", (i % 16 == 0) ? "\n        " : " ", h->moves[i]);
+    }
+    printf("\n    },\n");
+
+    printf("};\n");
+}
+
+// Add edges to Graph representing map of Europe
+static void addConnections(struct MapRep *g)
+{
+    //### ROAD Connections ###
+
+    addLink(g, ALICANTE, GRANADA, ROAD);
+    addLink(g, ALICANTE, MADRID, ROAD);
+    addLink(g, ALICANTE, SARAGOSSA, ROAD);
+    addLink(g, AMSTERDAM, BRUSSELS, ROAD);
+    addLink(g, AMSTERDAM, COLOGNE, ROAD);
+    addLink(g, ATHENS, VALONA, ROAD);
+    addLink(g, BARCELONA, SARAGOSSA, ROAD);
+    addLink(g, BARCELONA, TOULOUSE, ROAD);
+    addLink(g, BARI, NAPLES, ROAD);
+    addLink(g, BARI, ROME, ROAD);
+    addLink(g, BELGRADE, BUCHAREST, ROAD);
+    addLink(g, BELGRADE, KLAUSENBURG, ROAD);
+    addLink(g, BELGRADE, SARAJEVO, ROAD);
+    addLink(g, BELGRADE, SOFIA, ROAD);
+    addLink(g, BELGRADE, ST_JOSEPH_AND_ST_MARYS, ROAD);
+    addLink(g, BELGRADE, SZEGED, ROAD);
+    addLink(g, BERLIN, HAMBURG, ROAD);
+    addLink(g, BERLIN, LEIPZIG, ROAD);
+    addLink(g, BERLIN, PRAGUE, ROAD);
+    addLink(g, BORDEAUX, CLERMONT_FERRAND, ROAD);
+    addLink(g, BORDEAUX, NANTES, ROAD);
+    addLink(g, BORDEAUX, SARAGOSSA, ROAD);
+    addLink(g, BORDEAUX, TOULOUSE, ROAD);
+    addLink(g, BRUSSELS, COLOGNE, ROAD);
+    addLink(g, BRUSSELS, LE_HAVRE, ROAD);
+    addLink(g, BRUSSELS, PARIS, ROAD);
+    addLink(g, BRUSSELS, STRASBOURG, ROAD);
+    addLink(g, BUCHAREST, CONSTANTA, ROAD);
+    addLink(g, BUCHAREST, GALATZ, ROAD);
+    addLink(g, BUCHAREST, KLAUSENBURG, ROAD);
+    addLink(g, BUCHAREST, SOFIA, ROAD);
+    addLink(g, BUDAPEST, KLAUSENBURG, ROAD);
+    addLink(g, BUDAPEST, SZEGED, ROAD);
+    addLink(g, BUDAPEST, VIENNA, ROAD);
+    addLink(g, BUDAPEST, ZAGREB, ROAD);
+    addLink(g, CADIZ, GRANADA, ROAD);
+    addLink(g, CADIZ, LISBON, ROAD);
+    addLink(g, CADIZ, MADRID, ROAD);
+    addLink(g, CASTLE_DRACULA, GALATZ, ROAD);
+    addLink(g, CASTLE_DRACULA, KLAUSENBURG, ROAD);
+    addLink(g, CLERMONT_FERRAND, GENEVA, ROAD);
+    addLink(g, CLERMONT_FERRAND, MARSEILLES, ROAD);
+    addLink(g, CLERMONT_FERRAND, NANTES, ROAD);
+    addLink(g, CLERMONT_FERRAND, PARIS, ROAD);
+    addLink(g, CLERMONT_FERRAND, TOULOUSE, ROAD);
+    addLink(g, COLOGNE, FRANKFURT, ROAD);
+    addLink(g, COLOGNE, HAMBURG, ROAD);
+    addLink(g, COLOGNE, LEIPZIG, ROAD);
+    addLink(g, COLOGNE, STRASBOURG, ROAD);
+    addLink(g, CONSTANTA, GALATZ, ROAD);
+    addLink(g, CONSTANTA, VARNA, ROAD);
+    addLink(g, DUBLIN, GALWAY, ROAD);
+    addLink(g, EDINBURGH, MANCHESTER, ROAD);
+    addLink(g, FLORENCE, GENOA, ROAD);
+    addLink(g, FLORENCE, ROME, ROAD);
+    addLink(g, FLORENCE, VENICE, ROAD);
+    addLink(g, FRANKFURT, LEIPZIG, ROAD);
+    addLink(g, FRANKFURT, NUREMBURG, ROAD);
+    addLink(g, FRANKFURT, STRASBOURG, ROAD);
+    addLink(g, GALATZ, KLAUSENBURG, ROAD);
+    addLink(g, GENEVA, MARSEILLES, ROAD);
+    addLink(g, GENEVA, PARIS, ROAD);
+    addLink(g, GENEVA, STRASBOURG, ROAD);
+    addLink(g, GENEVA, ZURICH, ROAD);
+    addLink(g, GENOA, MARSEILLES, ROAD);
+    addLink(g, GENOA, MILAN, ROAD);
+    addLink(g, GENOA, VENICE, ROAD);
+    addLink(g, GRANADA, MADRID, ROAD);
+    addLink(g, HAMBURG, LEIPZIG, ROAD);
+    addLink(g, KLAUSENBURG, SZEGED, ROAD);
+    addLink(g, LEIPZIG, NUREMBURG, ROAD);
+    addLink(g, LE_HAVRE, NANTES, ROAD);
+    addLink(g, LE_HAVRE, PARIS, ROAD);
+    addLink(g, LISBON, MADRID, ROAD);
+    addLink(g, LISBON, SANTANDER, ROAD);
+    addLink(g, LIVERPOOL, MANCHESTER, ROAD);
+    addLink(g, LIVERPOOL, SWANSEA, ROAD);
+    addLink(g, LONDON, MANCHESTER, ROAD);
+    addLink(g, LONDON, PLYMOUTH, ROAD);
+    addLink(g, LONDON, SWANSEA, ROAD);
+    addLink(g, MADRID, SANTANDER, ROAD);
+    addLink(g, MADRID, SARAGOSSA, ROAD);
+    addLink(g, MARSEILLES, MILAN, ROAD);
+    addLink(g, MARSEILLES, TOULOUSE, ROAD);
+    addLink(g, MARSEILLES, ZURICH, ROAD);
+    addLink(g, MILAN, MUNICH, ROAD);
+    addLink(g, MILAN, VENICE, ROAD);
+    addLink(g, MILAN, ZURICH, ROAD);
+    addLink(g, MUNICH, NUREMBURG, ROAD);
+    addLink(g, MUNICH, STRASBOURG, ROAD);
+    addLink(g, MUNICH, VENICE, ROAD);
+    addLink(g, MUNICH, VIENNA, ROAD);
+    addLink(g, MUNICH, ZAGREB, ROAD);
+    addLink(g, MUNICH, ZURICH, ROAD);
+    addLink(g, NANTES, PARIS, ROAD);
+    addLink(g, NAPLES, ROME, ROAD);
+    addLink(g, NUREMBURG, PRAGUE, ROAD);
+    addLink(g, NUREMBURG, STRASBOURG, ROAD);
+    addLink(g, PARIS, STRASBOURG, ROAD);
+    addLink(g, PRAGUE, VIENNA, ROAD);
+    addLink(g, SALONICA, SOFIA, ROAD);
+    addLink(g, SALONICA, VALONA, ROAD);
+    addLink(g, SANTANDER, SARAGOSSA, ROAD);
+    addLink(g, SARAGOSSA, TOULOUSE, ROAD);
+    addLink(g, SARAJEVO, SOFIA, ROAD);
+    addLink(g, SARAJEVO, ST_JOSEPH_AND_ST_MARYS, ROAD);
+    addLink(g, SARAJEVO, VALONA, ROAD);
+    addLink(g, SARAJEVO, ZAGREB, ROAD);
+    addLink(g, SOFIA, VALONA, ROAD);
+    addLink(g, SOFIA, VARNA, ROAD);
+    addLink(g, STRASBOURG, ZURICH, ROAD);
+    addLink(g, ST_JOSEPH_AND_ST_MARYS, SZEGED, ROAD);
+    addLink(g, ST_JOSEPH_AND_ST_MARYS, ZAGREB, ROAD);
+    addLink(g, SZEGED, ZAGREB, ROAD);
+    addLink(g, VIENNA, ZAGREB, ROAD);
+
+    //### RAIL Connections ###
+
+    addLink(g, ALICANTE, BARCELONA, RAIL);
+    addLink(g, ALICANTE, MADRID, RAIL);
+    addLink(g, BARCELONA, SARAGOSSA, RAIL);
+    addLink(g, BARI, NAPLES, RAIL);
+    addLink(g, BELGRADE, SOFIA, RAIL);
+    addLink(g, BELGRADE, SZEGED, RAIL);
+    addLink(g, BERLIN, HAMBURG, RAIL);
+    addLink(g, BERLIN, LEIPZIG, RAIL);
+    addLink(g, BERLIN, PRAGUE, RAIL);
+    addLink(g, BORDEAUX, PARIS, RAIL);
+    addLink(g, BORDEAUX, SARAGOSSA, RAIL);
+    addLink(g, BRUSSELS, COLOGNE, RAIL);
+    addLink(g, BRUSSELS, PARIS, RAIL);
+    addLink(g, BUCHAREST, CONSTANTA, RAIL);
+    addLink(g, BUCHAREST, GALATZ, RAIL);
+    addLink(g, BUCHAREST, SZEGED, RAIL);
+    addLink(g, BUDAPEST, SZEGED, RAIL);
+    addLink(g, BUDAPEST, VIENNA, RAIL);
+    addLink(g, COLOGNE, FRANKFURT, RAIL);
+    addLink(g, EDINBURGH, MANCHESTER, RAIL);
+    addLink(g, FLORENCE, MILAN, RAIL);
+    addLink(g, FLORENCE, ROME, RAIL);
+    addLink(g, FRANKFURT, LEIPZIG, RAIL);
+    addLink(g, FRANKFURT, STRASBOURG, RAIL);
+    addLink(g, GENEVA, MILAN, RAIL);
+    addLink(g, GENOA, MILAN, RAIL);
+    addLink(g, LEIPZIG, NUREMBURG, RAIL);
+    addLink(g, LE_HAVRE, PARIS, RAIL);
+    addLink(g, LISBON, MADRID, RAIL);
+    addLink(g, LIVERPOOL, MANCHESTER, RAIL);
+    addLink(g, LONDON, MANCHESTER, RAIL);
+    addLink(g, LONDON, SWANSEA, RAIL);
+    addLink(g, MADRID, SANTANDER, RAIL);
+    addLink(g, MADRID, SARAGOSSA, RAIL);
+    addLink(g, MARSEILLES, PARIS, RAIL);
+    addLink(g, MILAN, ZURICH, RAIL);
+    addLink(g, MUNICH, NUREMBURG, RAIL);
+    addLink(g, NAPLES, ROME, RAIL);
+    addLink(g, PRAGUE, VIENNA, RAIL);
+    addLink(g, SALONICA, SOFIA, RAIL);
+    addLink(g, SOFIA, VARNA, RAIL);
+    addLink(g, STRASBOURG, ZURICH, RAIL);
+    addLink(g, VENICE, VIENNA, RAIL);
+
+    //### BOAT Connections ###
+
+    addLink(g, ADRIATIC_SEA, BARI, BOAT);
+    addLink(g, ADRIATIC_SEA, IONIAN_SEA, BOAT);
+    addLink(g, ADRIATIC_SEA, VENICE, BOAT);
+    addLink(g, ALICANTE, MEDITERRANEAN_SEA, BOAT);
+    addLink(g, AMSTERDAM, NORTH_SEA, BOAT);
+    addLink(g, ATHENS, IONIAN_SEA, BOAT);
+    addLink(g, ATLANTIC_OCEAN, BAY_OF_BISCAY, BOAT);
+    addLink(g, ATLANTIC_OCEAN, CADIZ, BOAT);
+    addLink(g, ATLANTIC_OCEAN, ENGLISH_CHANNEL, BOAT);
+    addLink(g, ATLANTIC_OCEAN, GALWAY, BOAT);
+    addLink(g, ATLANTIC_OCEAN, IRISH_SEA, BOAT);
+    addLink(g, ATLANTIC_OCEAN, LISBON, BOAT);
+    addLink(g, ATLANTIC_OCEAN, MEDITERRANEAN_SEA, BOAT);
+    addLink(g, ATLANTIC_OCEAN, NORTH_SEA, BOAT);
+    addLink(g, BARCELONA, MEDITERRANEAN_SEA, BOAT);
+    addLink(g, BAY_OF_BISCAY, BORDEAUX, BOAT);
+    addLink(g, BAY_OF_BISCAY, NANTES, BOAT);
+    addLink(g, BAY_OF_BISCAY, SANTANDER, BOAT);
+    addLink(g, BLACK_SEA, CONSTANTA, BOAT);
+    addLink(g, BLACK_SEA, IONIAN_SEA, BOAT);
+    addLink(g, BLACK_SEA, VARNA, BOAT);
+    addLink(g, CAGLIARI, MEDITERRANEAN_SEA, BOAT);
+    addLink(g, CAGLIARI, TYRRHENIAN_SEA, BOAT);
+    addLink(g, DUBLIN, IRISH_SEA, BOAT);
+    addLink(g, EDINBURGH, NORTH_SEA, BOAT);
+    addLink(g, ENGLISH_CHANNEL, LE_HAVRE, BOAT);
+    addLink(g, ENGLISH_CHANNEL, LONDON, BOAT);
+    addLink(g, ENGLISH_CHANNEL, NORTH_SEA, BOAT);
+    addLink(g, ENGLISH_CHANNEL, PLYMOUTH, BOAT);
+    addLink(g, GENOA, TYRRHENIAN_SEA, BOAT);
+    addLink(g, HAMBURG, NORTH_SEA, BOAT);
+    addLink(g, IONIAN_SEA, SALONICA, BOAT);
+    addLink(g, IONIAN_SEA, TYRRHENIAN_SEA, BOAT);
+    addLink(g, IONIAN_SEA, VALONA, BOAT);
+    addLink(g, IRISH_SEA, LIVERPOOL, BOAT);
+    addLink(g, IRISH_SEA, SWANSEA, BOAT);
+    addLink(g, MARSEILLES, MEDITERRANEAN_SEA, BOAT);
+    addLink(g, MEDITERRANEAN_SEA, TYRRHENIAN_SEA, BOAT);
+    addLink(g, NAPLES, TYRRHENIAN_SEA, BOAT);
+    addLink(g, ROME, TYRRHENIAN_SEA, BOAT);
+}